@@ -0,0 +1,179 @@
+#include "audio_capture.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+audio_capture::audio_capture(int len_ms) {
+    m_len_ms = len_ms;
+}
+
+audio_capture::~audio_capture() {
+    if (m_dev_id_in) {
+        SDL_CloseAudioDevice(m_dev_id_in);
+    }
+}
+
+bool audio_capture::init(int capture_id, int sample_rate) {
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        fprintf(stderr, "%s: couldn't initialize SDL: %s\n", __func__, SDL_GetError());
+        return false;
+    }
+
+    SDL_AudioSpec capture_spec_requested;
+    SDL_AudioSpec capture_spec_obtained;
+
+    SDL_zero(capture_spec_requested);
+    SDL_zero(capture_spec_obtained);
+
+    // Request int16 mono directly — SDL converts from whatever the hardware
+    // delivers, and the ring stores the samples without widening to float
+    capture_spec_requested.freq     = sample_rate;
+    capture_spec_requested.format   = AUDIO_S16SYS;
+    capture_spec_requested.channels = 1;
+    capture_spec_requested.samples  = 1024;
+    capture_spec_requested.userdata = this;
+    capture_spec_requested.callback = [](void* userdata, uint8_t* stream, int len) {
+        audio_capture* capture = (audio_capture*) userdata;
+        capture->callback(stream, len);
+    };
+
+    if (capture_id >= 0) {
+        m_dev_id_in = SDL_OpenAudioDevice(SDL_GetAudioDeviceName(capture_id, SDL_TRUE), SDL_TRUE,
+                                          &capture_spec_requested, &capture_spec_obtained, 0);
+    } else {
+        m_dev_id_in = SDL_OpenAudioDevice(nullptr, SDL_TRUE,
+                                          &capture_spec_requested, &capture_spec_obtained, 0);
+    }
+
+    if (!m_dev_id_in) {
+        fprintf(stderr, "%s: couldn't open an audio device for capture: %s\n", __func__, SDL_GetError());
+        return false;
+    }
+
+    m_sample_rate = capture_spec_obtained.freq;
+    m_audio.resize((m_sample_rate * m_len_ms) / 1000);
+
+    return true;
+}
+
+bool audio_capture::resume() {
+    if (!m_dev_id_in) {
+        fprintf(stderr, "%s: no audio device to resume!\n", __func__);
+        return false;
+    }
+    if (m_running) {
+        fprintf(stderr, "%s: already running!\n", __func__);
+        return false;
+    }
+
+    SDL_PauseAudioDevice(m_dev_id_in, 0);
+    m_running = true;
+
+    return true;
+}
+
+bool audio_capture::pause() {
+    if (!m_dev_id_in) {
+        fprintf(stderr, "%s: no audio device to pause!\n", __func__);
+        return false;
+    }
+    if (!m_running) {
+        fprintf(stderr, "%s: already paused!\n", __func__);
+        return false;
+    }
+
+    SDL_PauseAudioDevice(m_dev_id_in, 1);
+    m_running = false;
+
+    return true;
+}
+
+bool audio_capture::clear() {
+    if (!m_dev_id_in) {
+        fprintf(stderr, "%s: no audio device to clear!\n", __func__);
+        return false;
+    }
+    if (!m_running) {
+        fprintf(stderr, "%s: not running!\n", __func__);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_audio_pos = 0;
+    m_audio_len = 0;
+
+    return true;
+}
+
+void audio_capture::callback(uint8_t* stream, int len) {
+    if (!m_running) {
+        return;
+    }
+
+    size_t n_samples = len / sizeof(int16_t);
+    const int16_t* samples = (const int16_t*) stream;
+
+    // More than a full ring in one callback — keep the tail
+    if (n_samples > m_audio.size()) {
+        samples  += n_samples - m_audio.size();
+        n_samples = m_audio.size();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_audio_pos + n_samples > m_audio.size()) {
+        const size_t n0 = m_audio.size() - m_audio_pos;
+        memcpy(&m_audio[m_audio_pos], samples, n0 * sizeof(int16_t));
+        memcpy(&m_audio[0], samples + n0, (n_samples - n0) * sizeof(int16_t));
+    } else {
+        memcpy(&m_audio[m_audio_pos], samples, n_samples * sizeof(int16_t));
+    }
+
+    m_audio_pos = (m_audio_pos + n_samples) % m_audio.size();
+    m_audio_len = std::min(m_audio_len + n_samples, m_audio.size());
+}
+
+void audio_capture::get(int ms, std::vector<float>& result) {
+    if (!m_dev_id_in) {
+        fprintf(stderr, "%s: no audio device to get audio from!\n", __func__);
+        return;
+    }
+    if (!m_running) {
+        fprintf(stderr, "%s: not running!\n", __func__);
+        return;
+    }
+
+    result.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (ms <= 0) {
+        ms = m_len_ms;
+    }
+
+    size_t n_samples = (m_sample_rate * (size_t) ms) / 1000;
+    if (n_samples > m_audio_len) {
+        n_samples = m_audio_len;
+    }
+
+    result.resize(n_samples);
+
+    // int16 → float32 happens only here, on the requested span
+    size_t s0 = (m_audio_pos + m_audio.size() - n_samples) % m_audio.size();
+    for (size_t i = 0; i < n_samples; ++i) {
+        result[i] = m_audio[(s0 + i) % m_audio.size()] / 32768.0f;
+    }
+}
+
+bool sdl_poll_events() {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -8,12 +8,29 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <future>
+#include <mutex>
 #include <sstream>
 #include <unistd.h>
 
+#ifdef __APPLE__
+#include <Accelerate/Accelerate.h>
+#endif
+
 // RMS audio normalization to target dBFS level
 void normalize_audio(std::vector<float>& pcmf32, float target_dbfs) {
     if (pcmf32.empty()) return;
+#ifdef __APPLE__
+    // vDSP: single-pass RMS, then fused scale + clip (NEON-vectorized)
+    float rms = 0.0f;
+    vDSP_rmsqv(pcmf32.data(), 1, &rms, pcmf32.size());
+    if (rms < 1e-8f) return;  // silence
+    float target_rms = std::pow(10.0f, target_dbfs / 20.0f);
+    float gain = std::min(target_rms / rms, 10.0f);  // cap at +20dB
+    float lo = -1.0f, hi = 1.0f;
+    vDSP_vsmul(pcmf32.data(), 1, &gain, pcmf32.data(), 1, pcmf32.size());
+    vDSP_vclip(pcmf32.data(), 1, &lo, &hi, pcmf32.data(), 1, pcmf32.size());
+#else
     float sum_sq = 0.0f;
     for (const float s : pcmf32) sum_sq += s * s;
     float rms = std::sqrt(sum_sq / pcmf32.size());
@@ -21,14 +38,107 @@ void normalize_audio(std::vector<float>& pcmf32, float target_dbfs) {
     float target_rms = std::pow(10.0f, target_dbfs / 20.0f);
     float gain = std::min(target_rms / rms, 10.0f);  // cap at +20dB
     for (float& s : pcmf32) s = std::max(-1.0f, std::min(1.0f, s * gain));
+#endif
 }
 
-// Process audio with bilingual output support
-int process_audio_segment(struct whisper_context* ctx, struct whisper_context* ctx_translate,
-                         const whisper_params& params, const std::vector<float>& pcmf32,
-                         std::vector<BilingualSegment>& bilingual_results,
-                         const std::vector<whisper_token>& prompt_tokens) {
+// In-place 2nd-order Butterworth high-pass (cuts mic rumble / HVAC hum
+// below cutoff_hz before inference). whisper.cpp only high-pass filters
+// the VAD copy — the audio handed to whisper_full() was unfiltered.
+void high_pass_audio(std::vector<float>& pcmf32, float cutoff_hz, float sample_rate) {
+    if (pcmf32.size() < 3 || cutoff_hz <= 0.0f) return;
+
+    const double w0    = 2.0 * M_PI * cutoff_hz / sample_rate;
+    const double cosw0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * M_SQRT1_2); // Q = 1/sqrt(2)
+    const double a0    = 1.0 + alpha;
+
+    const double b0 =  (1.0 + cosw0) / 2.0 / a0;
+    const double b1 = -(1.0 + cosw0) / a0;
+    const double b2 =  (1.0 + cosw0) / 2.0 / a0;
+    const double a1 =  -2.0 * cosw0 / a0;
+    const double a2 =  (1.0 - alpha) / a0;
+
+#ifdef __APPLE__
+    const double coeffs[5] = { b0, b1, b2, a1, a2 };
+    vDSP_biquad_Setup setup = vDSP_biquad_CreateSetup(coeffs, 1);
+    if (setup) {
+        float delays[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        vDSP_biquad(setup, delays, pcmf32.data(), 1, pcmf32.data(), 1, pcmf32.size());
+        vDSP_biquad_DestroySetup(setup);
+        return;
+    }
+    // Setup allocation failed — fall through to the scalar path
+#endif
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    for (float& s : pcmf32) {
+        const double x = s;
+        const double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+        s = static_cast<float>(y);
+    }
+}
 
+// DSP stage applied in-place on the capture buffer before inference:
+// high-pass at freq_thold, then RMS normalization
+void preprocess_audio(std::vector<float>& pcmf32, const whisper_params& params) {
+    if (params.freq_thold > 0.0f) {
+        high_pass_audio(pcmf32, params.freq_thold, WHISPER_SAMPLE_RATE);
+    }
+    if (params.normalize_audio) {
+        normalize_audio(pcmf32);
+    }
+}
+
+// --partials draft display. whisper_full() fires the new-segment callback on
+// the inference (worker) thread while the main thread may be printing the
+// previous window's finalized text, so both paths serialize on one mutex.
+// Drafts occupy a single line redrawn with \r\033[2K in dim ANSI, are only
+// ever written to a TTY, and never touch the accumulation buffers — the
+// finalized segment replaces them through the normal print path.
+static std::mutex g_display_mutex;
+static bool g_partial_line_active = false;
+
+// Redraw the single dim draft line. Shows the tail if the text outgrows the
+// terminal, cutting on a UTF-8 boundary.
+static void print_draft_line(std::string draft) {
+    const size_t max_draft = 120;
+    if (draft.size() > max_draft) {
+        size_t cut = draft.size() - max_draft;
+        while (cut < draft.size() && (static_cast<unsigned char>(draft[cut]) & 0xC0) == 0x80) {
+            ++cut;
+        }
+        draft = "..." + draft.substr(cut);
+    }
+
+    std::lock_guard<std::mutex> lock(g_display_mutex);
+    printf("\r\033[2K\033[2m%s\033[0m", draft.c_str());
+    fflush(stdout);
+    g_partial_line_active = true;
+}
+
+static void partial_segment_callback(struct whisper_context* ctx, struct whisper_state* /*state*/,
+                                     int /*n_new*/, void* /*user_data*/) {
+    std::string draft;
+    const int n_segments = whisper_full_n_segments(ctx);
+    for (int i = 0; i < n_segments; ++i) {
+        draft += whisper_full_get_segment_text(ctx, i);
+    }
+    print_draft_line(std::move(draft));
+}
+
+// --draft-model: small resident context decoding each window in parallel with
+// the main context. Set once at startup, only read by the inference path.
+static struct whisper_context* g_ctx_draft = nullptr;
+
+void set_draft_context(struct whisper_context* ctx_draft) {
+    g_ctx_draft = ctx_draft;
+}
+
+// Process audio with bilingual output support
+// Shared whisper_full_params construction for the live and batch paths
+static whisper_full_params build_full_params(const whisper_params& params, size_t n_samples,
+                                             const std::vector<whisper_token>& prompt_tokens) {
     whisper_full_params wparams = whisper_full_default_params(params.beam_size > 1 ? WHISPER_SAMPLING_BEAM_SEARCH : WHISPER_SAMPLING_GREEDY);
 
     // Configure common parameters
@@ -39,7 +149,7 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
     // Force single segment for audio within whisper's 30-second window.
     // PTT chunks are ≤28s + 0.5s silence lead-in = ≤28.5s, so use 29s threshold.
     // For longer audio, allow multi-segment processing.
-    float audio_len_s = pcmf32.size() / static_cast<float>(WHISPER_SAMPLE_RATE);
+    float audio_len_s = n_samples / static_cast<float>(WHISPER_SAMPLE_RATE);
     wparams.single_segment   = (audio_len_s <= 29.0f);
     wparams.max_tokens       = params.max_tokens;
     wparams.language         = params.language.c_str();
@@ -88,12 +198,63 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
         }
     }
 
+    return wparams;
+}
+
+int process_audio_segment(struct whisper_context* ctx, struct whisper_state* state_translate,
+                         const whisper_params& params, const float* samples, size_t n_samples,
+                         std::vector<BilingualSegment>& bilingual_results,
+                         const std::vector<whisper_token>& prompt_tokens) {
+
+    whisper_full_params wparams = build_full_params(params, n_samples, prompt_tokens);
+
+    // Stream draft segments while the window decodes. Bilingual mode runs two
+    // decoders concurrently, so their drafts would interleave — keep the
+    // feature to the single-pass modes.
+    if (params.partials && params.output_mode != "bilingual" && isatty(STDOUT_FILENO)) {
+        wparams.new_segment_callback = partial_segment_callback;
+        wparams.new_segment_callback_user_data = nullptr;
+    }
+
+    // Draft pass: the --draft-model context decodes the same window greedily
+    // on a second thread and lands its text on the dim draft line well before
+    // the main decode returns. The future's destructor joins the pass before
+    // this function returns, so the samples pointer stays valid throughout.
+    std::future<void> draft_future;
+    if (g_ctx_draft && params.output_mode != "bilingual" && isatty(STDOUT_FILENO)) {
+        draft_future = std::async(std::launch::async, [&params, samples, n_samples]() {
+            whisper_full_params dwparams = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+            dwparams.print_progress   = false;
+            dwparams.print_realtime   = false;
+            dwparams.print_timestamps = false;
+            dwparams.print_special    = false;
+            dwparams.single_segment   = (n_samples / (float) WHISPER_SAMPLE_RATE) <= 29.0f;
+            dwparams.max_tokens       = params.max_tokens;
+            dwparams.language         = params.language.c_str();
+            dwparams.n_threads        = std::max(2, params.n_threads / 2);
+            dwparams.translate        = (params.output_mode == "english") &&
+                                        whisper_is_multilingual(g_ctx_draft);
+            dwparams.no_speech_thold  = params.no_speech_thold;
+            if (whisper_full(g_ctx_draft, dwparams, samples, n_samples) != 0) {
+                return;
+            }
+            std::string draft;
+            const int n_segments = whisper_full_n_segments(g_ctx_draft);
+            for (int i = 0; i < n_segments; ++i) {
+                draft += whisper_full_get_segment_text(g_ctx_draft, i);
+            }
+            if (!draft.empty()) {
+                print_draft_line(std::move(draft));
+            }
+        });
+    }
+
     bilingual_results.clear();
 
     if (params.output_mode == "original") {
         // Original language only
         wparams.translate = false;
-        if (whisper_full(ctx, wparams, pcmf32.data(), pcmf32.size()) != 0) {
+        if (whisper_full(ctx, wparams, samples, n_samples) != 0) {
             return -1;
         }
 
@@ -124,7 +285,7 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
     else if (params.output_mode == "english") {
         // English translation only
         wparams.translate = true;
-        if (whisper_full(ctx, wparams, pcmf32.data(), pcmf32.size()) != 0) {
+        if (whisper_full(ctx, wparams, samples, n_samples) != 0) {
             return -1;
         }
 
@@ -153,23 +314,32 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
         }
     }
     else if (params.output_mode == "bilingual") {
-        // Two-pass processing: original + translation
+        // Two-pass processing: original + translation.
+        // Both passes share one set of model weights: the translation decodes
+        // on its own whisper_state against the same ctx, over the same
+        // read-only PCM buffer. Dispatch it on a second thread and join
+        // before the timestamp-matching merge — the states are independent,
+        // so on Apple Silicon the encoder (ANE) and decoder (Metal) largely
+        // overlap between the passes, roughly halving bilingual latency.
+        whisper_full_params wparams_translate = wparams;
+        wparams_translate.translate = true;
+
+        auto translate_future = std::async(std::launch::async,
+            [ctx, state_translate, wparams_translate, samples, n_samples]() -> int {
+                return whisper_full_with_state(ctx, state_translate, wparams_translate, samples, n_samples);
+            });
 
-        // First pass: original language
         wparams.translate = false;
-        if (whisper_full(ctx, wparams, pcmf32.data(), pcmf32.size()) != 0) {
-            return -1;
-        }
+        const int rc_original = whisper_full(ctx, wparams, samples, n_samples);
+        const int rc_translate = translate_future.get();
 
-        // Second pass: translation
-        wparams.translate = true;
-        if (whisper_full(ctx_translate, wparams, pcmf32.data(), pcmf32.size()) != 0) {
+        if (rc_original != 0 || rc_translate != 0) {
             return -1;
         }
 
         // Merge results (using original segments as base, matching by timestamps)
         const int n_segments_orig = whisper_full_n_segments(ctx);
-        const int n_segments_trans = whisper_full_n_segments(ctx_translate);
+        const int n_segments_trans = whisper_full_n_segments_from_state(state_translate);
 
         for (int i = 0; i < n_segments_orig; ++i) {
             BilingualSegment seg;
@@ -191,8 +361,8 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
             seg.english_text = "";
             seg.english_confidence = 0.0f;
             for (int j = 0; j < n_segments_trans; ++j) {
-                int64_t trans_t0 = whisper_full_get_segment_t0(ctx_translate, j);
-                int64_t trans_t1 = whisper_full_get_segment_t1(ctx_translate, j);
+                int64_t trans_t0 = whisper_full_get_segment_t0_from_state(state_translate, j);
+                int64_t trans_t1 = whisper_full_get_segment_t1_from_state(state_translate, j);
 
                 // Check for overlap (allow some tolerance)
                 int64_t overlap_start = std::max(seg.t0, trans_t0);
@@ -200,17 +370,17 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
                 if (overlap_end > overlap_start) {
                     // Found overlapping segment
                     if (seg.english_text.empty()) {
-                        seg.english_text = whisper_full_get_segment_text(ctx_translate, j);
+                        seg.english_text = whisper_full_get_segment_text_from_state(state_translate, j);
                     } else {
-                        seg.english_text += " " + std::string(whisper_full_get_segment_text(ctx_translate, j));
+                        seg.english_text += " " + std::string(whisper_full_get_segment_text_from_state(state_translate, j));
                     }
 
                     // Update confidence (average)
-                    int trans_token_count = whisper_full_n_tokens(ctx_translate, j);
+                    int trans_token_count = whisper_full_n_tokens_from_state(state_translate, j);
                     if (trans_token_count > 0) {
                         float trans_confidence = 0.0f;
                         for (int k = 0; k < trans_token_count; ++k) {
-                            trans_confidence += whisper_full_get_token_p(ctx_translate, j, k);
+                            trans_confidence += whisper_full_get_token_p_from_state(state_translate, j, k);
                         }
                         trans_confidence /= trans_token_count;
                         seg.english_confidence = (seg.english_confidence + trans_confidence) / 2.0f;
@@ -227,6 +397,58 @@ int process_audio_segment(struct whisper_context* ctx, struct whisper_context* c
 }
 
 // Print tokens with confidence-based colors
+int process_audio_chunk_with_state(struct whisper_context* ctx, struct whisper_state* state,
+                                   const whisper_params& params, const float* samples, size_t n_samples,
+                                   int64_t t_offset_ms, std::vector<BilingualSegment>& results) {
+    whisper_full_params wparams = build_full_params(params, n_samples, {});
+
+    // Batch chunks want full segmentation and an uncapped decode — the
+    // streaming defaults (single segment, token cap) are latency tools
+    wparams.single_segment = false;
+    wparams.max_tokens = 0;
+    wparams.print_timestamps = false;
+    wparams.translate = params.output_mode == "english";
+    wparams.prompt_tokens = nullptr;
+    wparams.prompt_n_tokens = 0;
+
+    if (whisper_full_with_state(ctx, state, wparams, samples, n_samples) != 0) {
+        return -1;
+    }
+
+    const int64_t offset_cs = t_offset_ms / 10; // whisper timestamps are 10ms units
+    const int n_segments = whisper_full_n_segments_from_state(state);
+    results.clear();
+    for (int i = 0; i < n_segments; ++i) {
+        BilingualSegment seg;
+        seg.t0 = whisper_full_get_segment_t0_from_state(state, i) + offset_cs;
+        seg.t1 = whisper_full_get_segment_t1_from_state(state, i) + offset_cs;
+        std::string text = whisper_full_get_segment_text_from_state(state, i);
+        if (wparams.translate) {
+            seg.original_text = "";
+            seg.english_text = text;
+        } else {
+            seg.original_text = text;
+            seg.english_text = "";
+        }
+
+        float confidence = 0.0f;
+        int token_count = whisper_full_n_tokens_from_state(state, i);
+        if (token_count > 0) {
+            for (int j = 0; j < token_count; ++j) {
+                confidence += whisper_full_get_token_p_from_state(state, i, j);
+            }
+            confidence /= token_count;
+        }
+        seg.original_confidence = wparams.translate ? 0.0f : confidence;
+        seg.english_confidence = wparams.translate ? confidence : 0.0f;
+        seg.speaker_turn = whisper_full_get_segment_speaker_turn_next_from_state(state, i);
+
+        results.push_back(seg);
+    }
+
+    return 0;
+}
+
 void print_colored_tokens(whisper_context * ctx, int i_segment, const whisper_params& params) {
     for (int j = 0; j < whisper_full_n_tokens(ctx, i_segment); ++j) {
         if (params.print_special == false) {
@@ -266,9 +488,9 @@ bool should_auto_copy(const AutoCopySession& session, const whisper_params& para
         return false;
     }
 
-    // Check content size
-    std::string content = session.transcription_buffer.str();
-    if (content.size() > static_cast<size_t>(params.auto_copy_max_size_bytes)) {
+    // Check content size — the journal tracks this as a counter, so no
+    // full-buffer copy per segment
+    if (session.transcription_buffer.size() > static_cast<size_t>(params.auto_copy_max_size_bytes)) {
         return false;
     }
 
@@ -282,6 +504,14 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
                              bool tty_output, std::ostringstream* pipe_buffer,
                              bool accumulate) {
 
+    // Replace any lingering --partials draft with the finalized text; holding
+    // the lock also keeps the next window's drafts from interleaving with it
+    std::lock_guard<std::mutex> display_lock(g_display_mutex);
+    if (g_partial_line_active) {
+        printf("\r\033[2K");
+        g_partial_line_active = false;
+    }
+
     // Helper: route text to stdout (TTY) or pipe buffer
     auto out = [&](const std::string& text) {
         if (tty_output) { printf("%s", text.c_str()); }
@@ -289,9 +519,11 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
     };
 
     for (const auto& seg : segments) {
-        // Track speaker IDs via shared tracker
+        // Track speaker IDs via shared tracker. Remote (system-audio)
+        // segments never advance the local speaker ids — the remote side
+        // is one logical channel, not a diarized local speaker.
         int seg_speaker_id = speaker_tracker.get_current();
-        if (seg.speaker_turn) {
+        if (seg.speaker_turn && seg.channel == 0) {
             seg_speaker_id = speaker_tracker.on_turn();
         }
         if (params.no_timestamps) {
@@ -307,7 +539,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to export session
                     if (params.export_enabled) {
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             0, 0,
                             seg.original_text,
                             seg.original_confidence,
@@ -318,7 +550,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn);
+                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn, seg.channel);
                     }
                 }
             }
@@ -333,7 +565,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to export session
                     if (params.export_enabled) {
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             0, 0,
                             seg.english_text,
                             seg.english_confidence,
@@ -344,7 +576,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.english_text, seg.speaker_turn);
+                        meeting_session->add_transcription(seg.english_text, seg.speaker_turn, seg.channel);
                     }
                 }
             }
@@ -366,7 +598,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
                     // Add to export session (combine both texts)
                     if (params.export_enabled) {
                         std::string combined_text = lang_code + ": " + seg.original_text + "\nen: " + seg.english_text;
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             0, 0,
                             combined_text,
                             (seg.original_confidence + seg.english_confidence) / 2.0f,
@@ -377,10 +609,10 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session (clean format, just the content)
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn);
-                        meeting_session->add_transcription(" ");
-                        meeting_session->add_transcription(seg.english_text);
-                        meeting_session->add_transcription("\n");
+                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn, seg.channel);
+                        meeting_session->add_transcription(" ", false, seg.channel);
+                        meeting_session->add_transcription(seg.english_text, false, seg.channel);
+                        meeting_session->add_transcription("\n", false, seg.channel);
                     }
                 }
             }
@@ -404,7 +636,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to export session
                     if (params.export_enabled) {
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             seg.t0 / 10,
                             seg.t1 / 10,
                             seg.original_text,
@@ -416,8 +648,8 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session (clean format, just the content)
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn);
-                        meeting_session->add_transcription(" ");
+                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn, seg.channel);
+                        meeting_session->add_transcription(" ", false, seg.channel);
                     }
                 }
             }
@@ -436,7 +668,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to export session
                     if (params.export_enabled) {
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             seg.t0 / 10,
                             seg.t1 / 10,
                             seg.english_text,
@@ -448,8 +680,8 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session (clean format, just the content)
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.english_text, seg.speaker_turn);
-                        meeting_session->add_transcription(" ");
+                        meeting_session->add_transcription(seg.english_text, seg.speaker_turn, seg.channel);
+                        meeting_session->add_transcription(" ", false, seg.channel);
                     }
                 }
             }
@@ -475,7 +707,7 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
                     // Add to export session (combine both texts)
                     if (params.export_enabled) {
                         std::string combined_text = lang_code + ": " + seg.original_text + "\nen: " + seg.english_text;
-                        export_session.segments.emplace_back(
+                        export_session.add_segment(
                             seg.t0 / 10,
                             seg.t1 / 10,
                             combined_text,
@@ -487,10 +719,10 @@ void print_bilingual_results(const std::vector<BilingualSegment>& segments, cons
 
                     // Add to meeting session (clean format, just the content)
                     if (meeting_session && params.meeting_mode) {
-                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn);
-                        meeting_session->add_transcription(" ");
-                        meeting_session->add_transcription(seg.english_text);
-                        meeting_session->add_transcription(" ");
+                        meeting_session->add_transcription(seg.original_text, seg.speaker_turn, seg.channel);
+                        meeting_session->add_transcription(" ", false, seg.channel);
+                        meeting_session->add_transcription(seg.english_text, false, seg.channel);
+                        meeting_session->add_transcription(" ", false, seg.channel);
                     }
                 }
             }
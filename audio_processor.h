@@ -20,17 +20,50 @@ struct BilingualSegment {
     float english_confidence;
     bool speaker_turn;
     int speaker_id = -1;
+    int channel = 0;       // 0 = local mic, 1 = system/remote stream (--capture-system)
 };
 
 // RMS audio normalization
 void normalize_audio(std::vector<float>& pcmf32, float target_dbfs = -20.0f);
 
-// Whisper inference pipeline — processes audio into bilingual segments
-int process_audio_segment(struct whisper_context* ctx, struct whisper_context* ctx_translate,
-                          const whisper_params& params, const std::vector<float>& pcmf32,
+// In-place Butterworth high-pass (vDSP biquad on macOS, scalar fallback)
+void high_pass_audio(std::vector<float>& pcmf32, float cutoff_hz, float sample_rate);
+
+// Pre-inference DSP stage: high-pass at params.freq_thold + normalization
+void preprocess_audio(std::vector<float>& pcmf32, const whisper_params& params);
+
+// Register the --draft-model context: a small resident model that decodes
+// each window in parallel and feeds the dim draft line ahead of the main
+// decode. Set once at startup (nullptr disables).
+void set_draft_context(struct whisper_context* ctx_draft);
+
+// Whisper inference pipeline — processes audio into bilingual segments.
+// Reads a contiguous span, so callers can hand off ring-buffer windows
+// (see audio_ring.h) without an intermediate vector.
+// Bilingual mode runs the translation pass on state_translate (from
+// whisper_init_state() on the same ctx), so both passes share one set of
+// model weights; nullptr is fine for the other output modes.
+int process_audio_segment(struct whisper_context* ctx, struct whisper_state* state_translate,
+                          const whisper_params& params, const float* samples, size_t n_samples,
                           std::vector<BilingualSegment>& bilingual_results,
                           const std::vector<whisper_token>& prompt_tokens = {});
 
+// State-based variant for parallel batch chunks: several whisper_states
+// can run concurrently against one shared context. Segment timestamps are
+// offset by t_offset_ms so chunks reassemble on the file timeline.
+// Original/english modes only — bilingual needs the two-context live path.
+int process_audio_chunk_with_state(struct whisper_context* ctx, struct whisper_state* state,
+                                   const whisper_params& params, const float* samples, size_t n_samples,
+                                   int64_t t_offset_ms, std::vector<BilingualSegment>& results);
+
+inline int process_audio_segment(struct whisper_context* ctx, struct whisper_state* state_translate,
+                                 const whisper_params& params, const std::vector<float>& pcmf32,
+                                 std::vector<BilingualSegment>& bilingual_results,
+                                 const std::vector<whisper_token>& prompt_tokens = {}) {
+    return process_audio_segment(ctx, state_translate, params, pcmf32.data(), pcmf32.size(),
+                                 bilingual_results, prompt_tokens);
+}
+
 // Print tokens with confidence-based colors
 void print_colored_tokens(whisper_context* ctx, int i_segment, const whisper_params& params);
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// Power-of-two ring buffer staging mono float PCM between capture and
+// inference. Replaces the pcmf32_old/pcmf32_new/pcmf32 triple-buffer
+// shuffle in the sliding-window loop: capture appends each chunk once,
+// and the inference window (kept context + new samples) is read back as
+// a single contiguous span. The common case (no wrap) is zero-copy; a
+// window that straddles the wrap point costs one fixup copy into an
+// internal scratch buffer.
+//
+// The span returned by span() stays valid until subsequent push() calls
+// advance past it, so callers that process asynchronously must copy the
+// window out before capture continues.
+class AudioRing {
+public:
+    explicit AudioRing(size_t min_capacity) {
+        size_t cap = 1;
+        while (cap < min_capacity) cap <<= 1;
+        buf_.resize(cap);
+    }
+
+    size_t capacity() const { return buf_.size(); }
+    size_t size() const { return std::min(total_, buf_.size()); }
+
+    void clear() { total_ = 0; }
+
+    void push(const float* samples, size_t n) {
+        const size_t cap = buf_.size();
+        if (n >= cap) {
+            // Only the newest cap samples can survive
+            samples += n - cap;
+            n = cap;
+        }
+        const size_t pos = total_ & (cap - 1);
+        const size_t first = std::min(n, cap - pos);
+        memcpy(buf_.data() + pos, samples, first * sizeof(float));
+        if (n > first) {
+            memcpy(buf_.data(), samples + first, (n - first) * sizeof(float));
+        }
+        total_ += n;
+    }
+
+    void push(const std::vector<float>& samples) {
+        push(samples.data(), samples.size());
+    }
+
+    // The most recent n samples as one contiguous span (clamped to size())
+    const float* span(size_t n) {
+        const size_t cap = buf_.size();
+        n = std::min(n, size());
+        if (n == 0) {
+            return buf_.data();
+        }
+        const size_t end = total_ & (cap - 1);
+        if (n <= end) {
+            return buf_.data() + (end - n);
+        }
+        // Window straddles the wrap point — single fixup copy
+        scratch_.resize(n);
+        const size_t head = n - end; // oldest part, at the tail of buf_
+        memcpy(scratch_.data(), buf_.data() + (cap - head), head * sizeof(float));
+        memcpy(scratch_.data() + head, buf_.data(), end * sizeof(float));
+        return scratch_.data();
+    }
+
+private:
+    std::vector<float> buf_;
+    std::vector<float> scratch_;
+    size_t total_ = 0; // monotonic count of samples ever pushed
+};
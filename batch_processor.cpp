@@ -0,0 +1,173 @@
+#include "batch_processor.h"
+#include "text_processing.h"
+#include "perf_stats.h"
+
+#include "whisper.h"
+#include "common.h"
+#include "common-whisper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+    // Chunk sizing: aim for ~20s, never exceed 28s (headroom under
+    // whisper's 30s window), and prefer cutting inside a silent stretch
+    constexpr int CHUNK_TARGET_S = 20;
+    constexpr int CHUNK_MAX_S = 28;
+
+    struct BatchChunk {
+        size_t offset = 0; // sample offset into the decoded file
+        size_t length = 0;
+    };
+
+    // Walk the file and cut chunks on VAD boundaries: once past the target
+    // length, probe 1s windows and cut in the middle of the first silent
+    // one; force a cut at the max length when speech never pauses
+    std::vector<BatchChunk> split_on_vad(const std::vector<float>& pcm, const whisper_params& params) {
+        const size_t n_target = static_cast<size_t>(CHUNK_TARGET_S) * WHISPER_SAMPLE_RATE;
+        const size_t n_max = static_cast<size_t>(CHUNK_MAX_S) * WHISPER_SAMPLE_RATE;
+        const size_t n_win = WHISPER_SAMPLE_RATE; // 1s probe window
+
+        std::vector<BatchChunk> chunks;
+        size_t start = 0;
+        while (start < pcm.size()) {
+            const size_t remaining = pcm.size() - start;
+            if (remaining <= n_max) {
+                chunks.push_back({start, remaining});
+                break;
+            }
+
+            size_t cut = start + n_max;
+            for (size_t probe = start + n_target; probe + n_win <= start + n_max; probe += n_win / 2) {
+                // vad_simple() high-pass filters in place, so probe a copy
+                std::vector<float> window(pcm.begin() + probe, pcm.begin() + probe + n_win);
+                if (!::vad_simple(window, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false)) {
+                    cut = probe + n_win / 2;
+                    break;
+                }
+            }
+
+            chunks.push_back({start, cut - start});
+            start = cut;
+        }
+        return chunks;
+    }
+}
+
+bool run_batch_transcription(struct whisper_context* ctx, const whisper_params& params,
+                             std::vector<BilingualSegment>& segments, double& audio_seconds) {
+    segments.clear();
+    audio_seconds = 0.0;
+
+    if (!std::filesystem::exists(params.input_file)) {
+        fprintf(stderr, "error: input file not found: %s\n", params.input_file.c_str());
+        return false;
+    }
+
+    std::vector<float> pcmf32;
+    std::vector<std::vector<float>> pcmf32s;
+    if (!read_audio_data(params.input_file, pcmf32, pcmf32s, false) || pcmf32.empty()) {
+        fprintf(stderr, "error: failed to decode audio from %s\n", params.input_file.c_str());
+        return false;
+    }
+    audio_seconds = static_cast<double>(pcmf32.size()) / WHISPER_SAMPLE_RATE;
+
+    // One DSP pass over the whole file, then chunks reference the buffer
+    // read-only — no per-chunk copies
+    preprocess_audio(pcmf32, params);
+
+    const std::vector<BatchChunk> chunks = split_on_vad(pcmf32, params);
+    if (chunks.empty()) {
+        return true;
+    }
+
+    // Pool size: each state runs params.n_threads decode threads, so scale
+    // by available cores; states cost KV-cache memory, so cap at 4
+    int n_jobs = params.file_jobs;
+    if (n_jobs <= 0) {
+        int hw = std::max(1, (int) std::thread::hardware_concurrency());
+        n_jobs = std::max(1, std::min(4, hw / std::max(1, (int) params.n_threads)));
+    }
+    n_jobs = std::min<int>(n_jobs, chunks.size());
+
+    const bool stderr_tty = isatty(STDERR_FILENO);
+    if (stderr_tty) {
+        fprintf(stderr, "[Transcribing %.1f min in %zu chunks across %d workers]\n",
+                audio_seconds / 60.0, chunks.size(), n_jobs);
+    }
+
+    std::vector<std::vector<BilingualSegment>> chunk_results(chunks.size());
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> chunks_done{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&]() {
+        whisper_state* state = whisper_init_state(ctx);
+        if (!state) {
+            failed.store(true);
+            return;
+        }
+
+        while (!failed.load()) {
+            const size_t idx = next_chunk.fetch_add(1);
+            if (idx >= chunks.size()) break;
+
+            const BatchChunk& chunk = chunks[idx];
+            const int64_t t_offset_ms = static_cast<int64_t>(chunk.offset) * 1000 / WHISPER_SAMPLE_RATE;
+
+            perf_stats::ScopedTimer timer("whisper_full");
+            if (process_audio_chunk_with_state(ctx, state, params,
+                                               pcmf32.data() + chunk.offset, chunk.length,
+                                               t_offset_ms, chunk_results[idx]) != 0) {
+                failed.store(true);
+                break;
+            }
+
+            const size_t done = chunks_done.fetch_add(1) + 1;
+            if (stderr_tty) {
+                fprintf(stderr, "\r[%zu/%zu chunks]", done, chunks.size());
+                fflush(stderr);
+            }
+        }
+
+        whisper_free_state(state);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_jobs);
+    for (int i = 0; i < n_jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& t : threads) t.join();
+    if (stderr_tty) fprintf(stderr, "\n");
+
+    if (failed.load()) {
+        fprintf(stderr, "error: inference failed while transcribing %s\n", params.input_file.c_str());
+        return false;
+    }
+
+    // Reassemble in file order; chunk timestamps are already offset onto
+    // the file timeline, and hallucination filtering mirrors the live path
+    for (auto& results : chunk_results) {
+        for (auto& seg : results) {
+            if (!seg.original_text.empty()) {
+                seg.original_text = filter_hallucinations(seg.original_text);
+            }
+            if (!seg.english_text.empty()) {
+                seg.english_text = filter_hallucinations(seg.english_text);
+            }
+            if (seg.original_text.empty() && seg.english_text.empty()) {
+                continue;
+            }
+            segments.push_back(std::move(seg));
+        }
+    }
+
+    return true;
+}
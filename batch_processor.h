@@ -0,0 +1,14 @@
+#pragma once
+
+#include "whisper_params.h"
+#include "audio_processor.h"
+
+#include <vector>
+
+// Offline file transcription (--file): decodes an audio file, splits it on
+// VAD boundaries, and transcribes the chunks in parallel across a pool of
+// whisper_states sharing one context. Segments come back in timestamp
+// order, ready for the existing display/export/meeting pipeline.
+// Returns false if the file cannot be decoded or inference fails.
+bool run_batch_transcription(struct whisper_context* ctx, const whisper_params& params,
+                             std::vector<BilingualSegment>& segments, double& audio_seconds);
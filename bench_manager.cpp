@@ -0,0 +1,330 @@
+#include "bench_manager.h"
+#include "model_manager.h"
+#include "audio_processor.h"
+#include "whisper_params.h"
+
+#include "whisper.h"
+#include "common-whisper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+    void silent_log_callback(enum ggml_log_level, const char*, void*) {
+        // Keep whisper/ggml noise out of the benchmark report
+    }
+
+    struct BenchResult {
+        std::string model;
+        double load_ms = 0.0;
+        double warmup_ms = 0.0;
+        int chunks = 0;
+        double p50_ms = 0.0;
+        double p95_ms = 0.0;
+        double max_ms = 0.0;
+        double rtf = 0.0;        // inference time / audio time
+        double peak_rss_mb = 0.0;
+        bool ok = false;
+    };
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t idx = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+        return values[idx];
+    }
+
+    double peak_rss_mb() {
+        struct rusage ru{};
+        if (getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+#ifdef __APPLE__
+        return ru.ru_maxrss / (1024.0 * 1024.0); // bytes on macOS
+#else
+        return ru.ru_maxrss / 1024.0;            // kilobytes elsewhere
+#endif
+    }
+
+    // Deterministic fallback corpus: 30s of mixed tones + pseudo-noise.
+    // Not speech, but identical across runs — latency numbers stay
+    // comparable even on machines without a WAV corpus installed.
+    std::vector<float> synthetic_corpus() {
+        const size_t n = WHISPER_SAMPLE_RATE * 30;
+        std::vector<float> pcm(n);
+        uint32_t lcg = 12345;
+        for (size_t i = 0; i < n; ++i) {
+            lcg = lcg * 1664525u + 1013904223u;
+            float noise = (static_cast<float>(lcg >> 16) / 32768.0f - 1.0f) * 0.05f;
+            float t = static_cast<float>(i) / WHISPER_SAMPLE_RATE;
+            pcm[i] = 0.1f * std::sin(2.0f * 3.14159265f * 220.0f * t)
+                   + 0.05f * std::sin(2.0f * 3.14159265f * 440.0f * t)
+                   + noise;
+        }
+        return pcm;
+    }
+
+    std::string json_escape(const std::string& str) {
+        std::string escaped;
+        for (char c : str) {
+            switch (c) {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                default: escaped += c; break;
+            }
+        }
+        return escaped;
+    }
+
+    BenchResult bench_model(const std::string& model_name, const std::string& model_path,
+                            const std::vector<float>& corpus, int chunk_ms, int n_threads) {
+        BenchResult result;
+        result.model = model_name;
+
+        whisper_context_params cparams = whisper_context_default_params();
+        cparams.use_gpu = true;
+        cparams.flash_attn = true;
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        whisper_context* ctx = whisper_init_from_file_with_params(model_path.c_str(), cparams);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        if (!ctx) {
+            std::cerr << "error: failed to load " << model_name << "\n";
+            return result;
+        }
+        result.load_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+        // Warm-up mirrors the startup path: a 1s dummy inference that
+        // triggers CoreML/ANE compilation and Metal kernel JIT
+        whisper_params params;
+        params.model = model_path;
+        params.n_threads = n_threads;
+        params.output_mode = "original";
+        params.no_timestamps = true;
+        params.no_context = true;
+        params.max_tokens = 0;
+        params.normalize_audio = false; // measure inference, not DSP
+
+        {
+            std::vector<float> warmup(WHISPER_SAMPLE_RATE, 0.0f);
+            whisper_full_params wp = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+            wp.print_realtime   = false;
+            wp.print_progress   = false;
+            wp.print_timestamps = false;
+            wp.print_special    = false;
+            wp.n_threads        = n_threads;
+            wp.single_segment   = true;
+            wp.max_tokens       = 1;
+            auto tw0 = std::chrono::high_resolution_clock::now();
+            whisper_full(ctx, wp, warmup.data(), warmup.size());
+            auto tw1 = std::chrono::high_resolution_clock::now();
+            result.warmup_ms = std::chrono::duration<double, std::milli>(tw1 - tw0).count();
+        }
+
+        const size_t chunk_samples = static_cast<size_t>(1e-3 * chunk_ms) * WHISPER_SAMPLE_RATE;
+        std::vector<double> latencies;
+        double total_infer_ms = 0.0;
+
+        for (size_t offset = 0; offset + chunk_samples / 2 < corpus.size(); offset += chunk_samples) {
+            size_t n = std::min(chunk_samples, corpus.size() - offset);
+            std::vector<BilingualSegment> results;
+            auto tc0 = std::chrono::high_resolution_clock::now();
+            process_audio_segment(ctx, nullptr, params, corpus.data() + offset, n, results);
+            auto tc1 = std::chrono::high_resolution_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(tc1 - tc0).count();
+            latencies.push_back(ms);
+            total_infer_ms += ms;
+        }
+
+        whisper_free(ctx);
+
+        result.chunks = static_cast<int>(latencies.size());
+        result.p50_ms = percentile(latencies, 0.50);
+        result.p95_ms = percentile(latencies, 0.95);
+        result.max_ms = percentile(latencies, 1.00);
+        double audio_s = static_cast<double>(corpus.size()) / WHISPER_SAMPLE_RATE;
+        result.rtf = audio_s > 0.0 ? (total_infer_ms / 1000.0) / audio_s : 0.0;
+        result.peak_rss_mb = peak_rss_mb();
+        result.ok = true;
+        return result;
+    }
+
+    std::string results_to_json(const std::vector<BenchResult>& results,
+                                const std::vector<std::string>& corpus_files,
+                                double corpus_seconds, int chunk_ms, int n_threads) {
+        std::ostringstream json;
+        json << "{\n";
+#ifdef RECOGNIZE_VERSION
+        json << "  \"version\": \"" << RECOGNIZE_VERSION << "\",\n";
+#endif
+        json << "  \"threads\": " << n_threads << ",\n";
+        json << "  \"chunk_ms\": " << chunk_ms << ",\n";
+        json << "  \"corpus_seconds\": " << corpus_seconds << ",\n";
+        json << "  \"corpus\": [";
+        for (size_t i = 0; i < corpus_files.size(); ++i) {
+            if (i > 0) json << ", ";
+            json << "\"" << json_escape(corpus_files[i]) << "\"";
+        }
+        json << "],\n";
+        json << "  \"results\": [\n";
+        bool first = true;
+        for (const auto& r : results) {
+            if (!r.ok) continue;
+            if (!first) json << ",\n";
+            first = false;
+            json << "    {\"model\": \"" << json_escape(r.model) << "\""
+                 << ", \"load_ms\": " << static_cast<int64_t>(r.load_ms)
+                 << ", \"warmup_ms\": " << static_cast<int64_t>(r.warmup_ms)
+                 << ", \"chunks\": " << r.chunks
+                 << ", \"latency_ms\": {\"p50\": " << static_cast<int64_t>(r.p50_ms)
+                 << ", \"p95\": " << static_cast<int64_t>(r.p95_ms)
+                 << ", \"max\": " << static_cast<int64_t>(r.max_ms) << "}"
+                 << ", \"rtf\": " << r.rtf
+                 << ", \"peak_rss_mb\": " << static_cast<int64_t>(r.peak_rss_mb)
+                 << "}";
+        }
+        json << "\n  ]\n}\n";
+        return json.str();
+    }
+}
+
+int handle_bench_command(int argc, char** argv) {
+    std::vector<std::string> model_args;
+    std::vector<std::string> wav_files;
+    std::string output_file;
+    int chunk_ms = 10000;
+    int n_threads = std::min(4, (int) std::thread::hardware_concurrency());
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--models" && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string name;
+            while (std::getline(ss, name, ',')) {
+                if (!name.empty()) model_args.push_back(name);
+            }
+        } else if (arg == "--wav" && i + 1 < argc) {
+            wav_files.push_back(argv[++i]);
+        } else if (arg == "--chunk-ms" && i + 1 < argc) {
+            try { chunk_ms = std::stoi(argv[++i]); } catch (const std::exception&) {}
+        } else if (arg == "--threads" && i + 1 < argc) {
+            try { n_threads = std::stoi(argv[++i]); } catch (const std::exception&) {}
+        } else if (arg == "-o" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << "usage: recognize bench [--models a,b,c] [--wav FILE]... "
+                         "[--chunk-ms N] [--threads N] [-o FILE]\n\n"
+                         "Benchmarks downloaded models against a WAV corpus "
+                         "(~/.recognize/bench/*.wav by default, a deterministic\n"
+                         "synthetic signal when none exists) and prints JSON.\n";
+            return 0;
+        } else {
+            std::cerr << "error: unknown bench argument '" << arg << "'\n";
+            return 1;
+        }
+    }
+    if (chunk_ms < 1000) chunk_ms = 1000;
+
+    ModelManager model_manager;
+
+    // Default model list: every downloaded model, in registry order
+    std::vector<std::string> models;
+    if (!model_args.empty()) {
+        models = model_args;
+    } else {
+        auto downloaded = model_manager.get_downloaded_models();
+        for (const auto& name : model_manager.get_model_names()) {
+            if (std::find(downloaded.begin(), downloaded.end(), name) != downloaded.end()) {
+                models.push_back(name);
+            }
+        }
+    }
+    if (models.empty()) {
+        std::cerr << "error: no downloaded models to benchmark\n"
+                  << "hint: recognize --list-models\n";
+        return 1;
+    }
+
+    // Default corpus: ~/.recognize/bench/*.wav
+    if (wav_files.empty()) {
+        const char* home = getenv("HOME");
+        if (home) {
+            std::string bench_dir = std::string(home) + "/.recognize/bench";
+            if (std::filesystem::is_directory(bench_dir)) {
+                for (const auto& entry : std::filesystem::directory_iterator(bench_dir)) {
+                    if (entry.path().extension() == ".wav") {
+                        wav_files.push_back(entry.path().string());
+                    }
+                }
+                std::sort(wav_files.begin(), wav_files.end());
+            }
+        }
+    }
+
+    std::vector<float> corpus;
+    std::vector<std::string> corpus_files;
+    for (const auto& fname : wav_files) {
+        std::vector<float> pcmf32;
+        std::vector<std::vector<float>> pcmf32s;
+        if (!read_audio_data(fname, pcmf32, pcmf32s, false)) {
+            std::cerr << "error: failed to read " << fname << "\n";
+            return 1;
+        }
+        corpus.insert(corpus.end(), pcmf32.begin(), pcmf32.end());
+        corpus_files.push_back(fname);
+    }
+    if (corpus.empty()) {
+        std::cerr << "note: no WAV corpus found — using a 30s deterministic synthetic signal\n";
+        corpus = synthetic_corpus();
+        corpus_files.push_back("<synthetic>");
+    }
+    double corpus_seconds = static_cast<double>(corpus.size()) / WHISPER_SAMPLE_RATE;
+
+    whisper_log_set(silent_log_callback, nullptr);
+    ggml_log_set(silent_log_callback, nullptr);
+
+    std::vector<BenchResult> results;
+    for (const auto& name : models) {
+        if (!model_manager.model_exists(name)) {
+            std::cerr << "skipping " << name << " (not downloaded)\n";
+            continue;
+        }
+        std::cerr << "benchmarking " << name << "...\n";
+        results.push_back(bench_model(name, model_manager.get_model_path(name),
+                                      corpus, chunk_ms, n_threads));
+    }
+
+    std::string json = results_to_json(results, corpus_files, corpus_seconds, chunk_ms, n_threads);
+    std::cout << json;
+
+    // Always keep the latest run in ~/.recognize/bench-cache.json so later
+    // runs (and tooling) can diff against it
+    const char* home = getenv("HOME");
+    if (home) {
+        std::ofstream cache(std::string(home) + "/.recognize/bench-cache.json", std::ios::trunc);
+        if (cache) cache << json;
+    }
+    if (!output_file.empty()) {
+        std::ofstream out(output_file, std::ios::trunc);
+        if (!out) {
+            std::cerr << "error: cannot write " << output_file << "\n";
+            return 1;
+        }
+        out << json;
+    }
+
+    bool all_ok = !results.empty() &&
+                  std::all_of(results.begin(), results.end(),
+                              [](const BenchResult& r) { return r.ok; });
+    return all_ok ? 0 : 1;
+}
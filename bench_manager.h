@@ -0,0 +1,8 @@
+#pragma once
+
+// Benchmark harness for the "recognize bench" subcommand.
+// Runs a fixed WAV corpus through process_audio_segment() across a list
+// of downloaded models and reports model load time, CoreML warm-up time,
+// per-chunk latency percentiles, real-time factor, and peak RSS as JSON —
+// so perf runs can be diffed between releases.
+int handle_bench_command(int argc, char** argv);
@@ -52,7 +52,7 @@ bool whisper_params_parse(int argc, char ** argv, whisper_params & params) {
         else if (arg == "-kc"   || arg == "--keep-context")  { params.no_context    = false; }
         else if (arg == "-l"    || arg == "--language")      { if (!require_arg(i, arg)) return false; params.language      = argv[++i]; }
         else if (arg == "-m"    || arg == "--model")         { if (!require_arg(i, arg)) return false; params.model         = argv[++i]; }
-        else if (arg == "-f"    || arg == "--file")          { if (!require_arg(i, arg)) return false; params.fname_out     = argv[++i]; }
+        else if (arg == "-f")                                { if (!require_arg(i, arg)) return false; params.fname_out     = argv[++i]; }
         else if (arg == "-om"   || arg == "--output-mode")   { if (!require_arg(i, arg)) return false; params.output_mode   = argv[++i]; }
         else if (arg == "-tdrz" || arg == "--tinydiarize")   { params.tinydiarize   = true; }
         else if (arg == "-sa"   || arg == "--save-audio")    { params.save_audio    = true; }
@@ -84,6 +84,7 @@ bool whisper_params_parse(int argc, char ** argv, whisper_params & params) {
         else if (arg == "--export-no-metadata")              { params.export_include_metadata = false; }
         else if (arg == "--export-no-timestamps")            { params.export_include_timestamps = false; }
         else if (arg == "--export-include-confidence")       { params.export_include_confidence = true; }
+        else if (arg == "--export-stream")                   { params.export_enabled = true; params.export_stream = true; }
         // Meeting options
         else if (arg == "--meeting")                         { params.meeting_mode = true; }
         else if (arg == "--no-meeting")                      { params.meeting_mode = false; }
@@ -111,10 +112,29 @@ bool whisper_params_parse(int argc, char ** argv, whisper_params & params) {
         else if (arg == "--ptt-loop")                         { params.ptt_mode = true; params.ptt_loop = true; }
         else if (arg == "--ptt-key")                          { if (!require_arg(i, arg)) return false; params.ptt_key = argv[++i]; }
         else if (arg == "--ptt-pre-roll")                     { if (!require_arg(i, arg)) return false; params.ptt_pre_roll_ms = std::stoi(argv[++i]); }
+        // Server mode
+        else if (arg == "--serve")                            { params.serve = true; }
+        else if (arg == "--client")                           { params.client = true; }
+        // Offline file transcription
+        else if (arg == "--file")                             { if (!require_arg(i, arg)) return false; params.input_file = argv[++i]; }
+        else if (arg == "--file-jobs")                        { if (!require_arg(i, arg)) return false; params.file_jobs = std::stoi(argv[++i]); }
+        // Partial results
+        else if (arg == "--partials")                         { params.partials = true; }
+        // Adaptive step sizing
+        else if (arg == "--adaptive-step")                    { params.adaptive_step = true; }
+        // Draft model
+        else if (arg == "--draft-model")                      { if (!require_arg(i, arg)) return false; params.draft_model = argv[++i]; }
+        // VAD gate
+        else if (arg == "--vad-gate")                         { params.vad_gate = true; }
+        // Dual-stream capture
+        else if (arg == "--capture-system")                   { if (!require_arg(i, arg)) return false; params.capture_system_id = std::stoi(argv[++i]); }
         // Refinement
         else if (arg == "-r"    || arg == "--refine")         { params.refine = true; }
         // History
         else if (arg == "--no-history")                       { params.history_enabled = false; }
+        // Diagnostics
+        else if (arg == "--stats")                            { params.stats = true; }
+        else if (arg == "--stats-stream")                     { params.stats = true; params.stats_stream = true; }
         // Config management options
         else if (arg == "config") {
             if (i + 1 < argc) {
@@ -203,10 +223,15 @@ void whisper_print_usage(int /*argc*/, char ** argv, const whisper_params & para
     fprintf(stderr, "  -nf,      --no-fallback   [%-7s] do not use temperature fallback while decoding\n", params.no_fallback ? "true" : "false");
     fprintf(stderr, "  -ps,      --print-special [%-7s] print special tokens\n",                           params.print_special ? "true" : "false");
     fprintf(stderr, "  -pc,      --print-colors  [%-7s] print colors based on token confidence\n",         params.print_colors ? "true" : "false");
+    fprintf(stderr, "            --partials      [%-7s] stream dim draft text while each chunk decodes (TTY only)\n", params.partials ? "true" : "false");
+    fprintf(stderr, "            --adaptive-step [%-7s] scale step size with measured decode speed\n",     params.adaptive_step ? "true" : "false");
+    fprintf(stderr, "            --draft-model NAME [%-7s] small model drafting the dim line ahead of the main decode\n", params.draft_model.empty() ? "none" : params.draft_model.c_str());
+    fprintf(stderr, "            --vad-gate      [%-7s] skip inference for capture chunks with no speech\n",  params.vad_gate ? "true" : "false");
+    fprintf(stderr, "            --capture-system ID [%-3d] system-audio (loopback) device for meeting mode, decoded in parallel\n", params.capture_system_id);
     fprintf(stderr, "  -kc,      --keep-context  [%-7s] keep context between audio chunks\n",              params.no_context ? "false" : "true");
     fprintf(stderr, "  -l LANG,  --language LANG [%-7s] spoken language\n",                                params.language.c_str());
-    fprintf(stderr, "  -m FNAME, --model FNAME   [%-7s] model path\n",                                     params.model.c_str());
-    fprintf(stderr, "  -f FNAME, --file FNAME    [%-7s] text output file name\n",                          params.fname_out.c_str());
+    fprintf(stderr, "  -m FNAME, --model FNAME   [%-7s] model name, path, or 'auto' (pick for this machine)\n", params.model.c_str());
+    fprintf(stderr, "  -f FNAME                  [%-7s] text output file name\n",                          params.fname_out.c_str());
     fprintf(stderr, "  -om MODE, --output-mode MODE [%-7s] output mode: original, english, bilingual\n",    params.output_mode.c_str());
     fprintf(stderr, "  -tdrz,    --tinydiarize   [%-7s] enable speaker segmentation (requires tdrz model)\n", params.tinydiarize ? "true" : "false");
     fprintf(stderr, "  -sa,      --save-audio    [%-7s] save the recorded audio to a file\n",              params.save_audio ? "true" : "false");
@@ -227,12 +252,13 @@ void whisper_print_usage(int /*argc*/, char ** argv, const whisper_params & para
     fprintf(stderr, "export options:\n");
     fprintf(stderr, "            --export        [%-7s] enable transcription export when session ends\n", params.export_enabled ? "true" : "false");
     fprintf(stderr, "            --no-export     [%-7s] disable transcription export\n",                params.export_enabled ? "false" : "true");
-    fprintf(stderr, "            --export-format FORMAT [%-7s] export format: txt, md, json, csv, srt, vtt, xml\n", params.export_format.c_str());
+    fprintf(stderr, "            --export-format FORMAT [%-7s] export format: txt, md, json, csv, srt, vtt, xml, jsonl\n", params.export_format.c_str());
     fprintf(stderr, "            --export-file FILE      [%-7s] export to specific file (default: auto-generated)\n", params.export_file.c_str());
     fprintf(stderr, "            --export-auto-filename  [%-7s] generate automatic filename\n",          params.export_auto_filename ? "true" : "false");
     fprintf(stderr, "            --export-no-metadata    [%-7s] exclude session metadata from export\n", params.export_include_metadata ? "false" : "true");
     fprintf(stderr, "            --export-no-timestamps  [%-7s] exclude timestamps from export\n",     params.export_include_timestamps ? "false" : "true");
     fprintf(stderr, "            --export-include-confidence [%-7s] include confidence scores in export\n", params.export_include_confidence ? "true" : "false");
+    fprintf(stderr, "            --export-stream         [%-7s] append segments to disk as they finalize (crash-safe, not json/xml)\n", params.export_stream ? "true" : "false");
     fprintf(stderr, "\n");
     fprintf(stderr, "meeting organization:\n");
     fprintf(stderr, "            --meeting        [%-7s] enable meeting transcription mode\n", params.meeting_mode ? "true" : "false");
@@ -262,10 +288,22 @@ void whisper_print_usage(int /*argc*/, char ** argv, const whisper_params & para
     fprintf(stderr, "            --ptt-key KEY      [%-7s] PTT key: space, right_option, right_ctrl, fn, f13\n", params.ptt_key.c_str());
     fprintf(stderr, "            --ptt-pre-roll N   [%-7d] pre-roll audio in ms before key press\n", params.ptt_pre_roll_ms);
     fprintf(stderr, "\n");
+    fprintf(stderr, "server:\n");
+    fprintf(stderr, "            --serve            [%-7s] keep model resident, serve sessions over a Unix socket\n", params.serve ? "true" : "false");
+    fprintf(stderr, "            --client           [%-7s] run against a resident --serve process (instant start)\n", params.client ? "true" : "false");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "offline transcription:\n");
+    fprintf(stderr, "            --file FILE        transcribe a recording (VAD-chunked, parallel workers)\n");
+    fprintf(stderr, "            --file-jobs N      [%-7d] parallel decode workers for --file (0 = auto)\n", params.file_jobs);
+    fprintf(stderr, "\n");
     fprintf(stderr, "refinement:\n");
     fprintf(stderr, "  -r,       --refine           [%-7s] refine transcript via Claude CLI (ASR error correction)\n", params.refine ? "true" : "false");
     fprintf(stderr, "  --no-history                  [%-7s] do not save transcript to history\n", "false");
     fprintf(stderr, "\n");
+    fprintf(stderr, "diagnostics:\n");
+    fprintf(stderr, "            --stats            [%-7s] per-stage timing summary (JSON on stderr) at exit\n", params.stats ? "true" : "false");
+    fprintf(stderr, "            --stats-stream     [%-7s] also print one JSON line per timing sample\n", params.stats_stream ? "true" : "false");
+    fprintf(stderr, "\n");
     fprintf(stderr, "model management:\n");
     fprintf(stderr, "            --list-models      list available models for download\n");
     fprintf(stderr, "            --list-downloaded  list downloaded models with sizes and paths\n");
@@ -304,7 +342,7 @@ void whisper_print_usage(int /*argc*/, char ** argv, const whisper_params & para
     fprintf(stderr, "\n");
     fprintf(stderr, "subcommands:\n");
     fprintf(stderr, "  config [list|set|get|unset|reset]        manage configuration\n");
-    fprintf(stderr, "  history [list|search|show|clear|count]   transcription history\n");
+    fprintf(stderr, "  history [list|search|show|clear|count|reindex]   transcription history\n");
     fprintf(stderr, "\n");
 }
 
@@ -340,7 +378,7 @@ int handle_history_command(int argc, char** argv) {
     std::string subcmd = (argc >= 1) ? argv[0] : "list";
     bool json_output = false;
     int limit = 20;
-    int offset = 0;
+    int64_t before_id = 0;
 
     // Safe integer parsing — returns default_val on invalid input
     auto safe_stoi = [](const char* s, int default_val = 0) -> int {
@@ -365,14 +403,14 @@ int handle_history_command(int argc, char** argv) {
         return 1;
     }
 
-    if (subcmd == "list" || subcmd == "--json" || subcmd == "--limit" || subcmd == "--offset") {
+    if (subcmd == "list" || subcmd == "--json" || subcmd == "--limit" || subcmd == "--before") {
         // "recognize history" with just flags defaults to list
         for (int i = 0; i < argc; i++) {
             std::string arg = argv[i];
             if (arg == "--limit" && i + 1 < argc) limit = safe_stoi(argv[++i], 20);
-            else if (arg == "--offset" && i + 1 < argc) offset = safe_stoi(argv[++i], 0);
+            else if (arg == "--before" && i + 1 < argc) before_id = safe_stoll(argv[++i], 0);
         }
-        auto entries = history.list(limit, offset);
+        auto entries = history.list(limit, before_id);
         std::cout << (json_output ? HistoryManager::format_json(entries) : HistoryManager::format_table(entries));
         return 0;
     }
@@ -483,6 +521,22 @@ int handle_history_command(int argc, char** argv) {
         return 0;
     }
 
+    if (subcmd == "reindex") {
+        std::cerr << "Rebuilding full-text index...\n";
+        if (!history.reindex()) {
+            std::cerr << "error: reindex failed\n";
+            return 1;
+        }
+        std::cerr << "Reindexed " << history.count() << " entries.\n";
+        return 0;
+    }
+
+    if (subcmd == "prune") {
+        history.prune();
+        std::cerr << "History pruned (" << history.count() << " entries kept).\n";
+        return 0;
+    }
+
     if (subcmd == "count") {
         int total = history.count();
         if (json_output) {
@@ -494,6 +548,6 @@ int handle_history_command(int argc, char** argv) {
     }
 
     std::cerr << "error: unknown history command: " << subcmd << "\n"
-              << "usage: recognize history [list|search|show|clear|count]\n";
+              << "usage: recognize history [list|search|show|clear|count|prune|reindex]\n";
     return 1;
 }
@@ -3,10 +3,16 @@
 #include <fstream>
 #include <filesystem>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 // Simple JSON handling without external dependencies
 namespace {
     // Basic JSON escape function
@@ -28,7 +34,7 @@ namespace {
     }
     
     // Basic JSON unescape function
-    std::string unescape_json_string(const std::string& str) {
+    std::string unescape_json_string(std::string_view str) {
         std::string unescaped;
         for (size_t i = 0; i < str.length(); ++i) {
             if (str[i] == '\\' && i + 1 < str.length()) {
@@ -49,40 +55,44 @@ namespace {
         return unescaped;
     }
     
-    // Extract JSON value (simple parser for our use case)
-    std::string extract_json_value(const std::string& json, const std::string& key) {
-        std::string search = "\"" + key + "\"";
-        size_t pos = json.find(search);
-        if (pos == std::string::npos) return "";
-        
-        pos = json.find(':', pos);
-        if (pos == std::string::npos) return "";
-        
-        // Skip whitespace
-        ++pos;
-        while (pos < json.length() && std::isspace(json[pos])) ++pos;
-        
-        if (pos >= json.length()) return "";
-        
-        if (json[pos] == '"') {
-            // String value
-            ++pos;
-            size_t end = json.find('"', pos);
-            if (end == std::string::npos) return "";
-            return unescape_json_string(json.substr(pos, end - pos));
-        } else {
-            // Non-string value (number, boolean, null)
-            size_t end = pos;
-            while (end < json.length() && json[end] != ',' && json[end] != '}' && json[end] != ']') {
-                ++end;
-            }
-            std::string value = json.substr(pos, end - pos);
-            // Trim whitespace
-            value.erase(0, value.find_first_not_of(" \t\n\r"));
-            value.erase(value.find_last_not_of(" \t\n\r") + 1);
-            return value;
-        }
+    // Materialize a raw JSON string token into an owned string — the only
+    // point in the parse where we allocate for a value
+    std::string materialize_string(std::string_view raw) {
+        if (raw.find('\\') == std::string_view::npos) return std::string(raw);
+        return unescape_json_string(raw);
+    }
+
+    // Numeric parsing without the std::string round-trip std::stoi/stof need.
+    // Config values are short; anything that doesn't fit the buffer is junk.
+    std::optional<int> parse_int_token(std::string_view v) {
+        char buf[32];
+        if (v.empty() || v.size() >= sizeof(buf)) return std::nullopt;
+        std::memcpy(buf, v.data(), v.size());
+        buf[v.size()] = '\0';
+        char* end = nullptr;
+        long n = std::strtol(buf, &end, 10);
+        if (end == buf) return std::nullopt;
+        return static_cast<int>(n);
     }
+
+    std::optional<float> parse_float_token(std::string_view v) {
+        char buf[48];
+        if (v.empty() || v.size() >= sizeof(buf)) return std::nullopt;
+        std::memcpy(buf, v.data(), v.size());
+        buf[v.size()] = '\0';
+        char* end = nullptr;
+        float f = std::strtof(buf, &end);
+        if (end == buf) return std::nullopt;
+        return f;
+    }
+
+    // Parsed-config cache entry: an unchanged file parses to the same
+    // ConfigData, so mtime+size lets repeated loads skip the parse
+    struct CachedConfig {
+        time_t mtime = 0;
+        off_t size = 0;
+        ConfigData data;
+    };
 }
 
 ConfigManager::ConfigManager() {
@@ -530,13 +540,49 @@ ConfigData ConfigManager::get_effective_config() const {
 }
 
 ConfigData ConfigManager::load_config_file(const std::string& filepath) const {
-    std::ifstream file(filepath);
-    if (!file) return ConfigData{};
-    
-    std::string json_str((std::istreambuf_iterator<char>(file)),
-                         std::istreambuf_iterator<char>());
-    
-    return json_to_config(json_str);
+    struct stat st{};
+    if (::stat(filepath.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        return ConfigData{};
+    }
+
+    // Fast path: config is reloaded per session by the PTT daemon and
+    // --serve loops; an unchanged mtime+size means an identical parse,
+    // so return the cached result. Only touched from the main thread.
+    static std::map<std::string, CachedConfig> parse_cache;
+    auto it = parse_cache.find(filepath);
+    if (it != parse_cache.end() &&
+        it->second.mtime == st.st_mtime && it->second.size == st.st_size) {
+        return it->second.data;
+    }
+
+    ConfigData config;
+    bool parsed = false;
+
+    // Parse straight off a read-only mapping — no copy of the file into a
+    // std::string; the parser only allocates for values it keeps
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        void* map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            config = json_to_config(std::string_view(static_cast<const char*>(map),
+                                                     static_cast<size_t>(st.st_size)));
+            ::munmap(map, static_cast<size_t>(st.st_size));
+            parsed = true;
+        }
+        ::close(fd);
+    }
+
+    if (!parsed) {
+        // mmap can fail on some filesystems — fall back to a buffered read
+        std::ifstream file(filepath);
+        if (!file) return ConfigData{};
+        std::string json_str((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+        config = json_to_config(json_str);
+    }
+
+    parse_cache[filepath] = CachedConfig{st.st_mtime, st.st_size, config};
+    return config;
 }
 
 bool ConfigManager::save_config_file(const std::string& filepath, const ConfigData& config) const {
@@ -708,97 +754,148 @@ std::string ConfigManager::config_to_json(const ConfigData& config) const {
     return json.str();
 }
 
-ConfigData ConfigManager::json_to_config(const std::string& json_str) const {
+ConfigData ConfigManager::json_to_config(std::string_view json) const {
     ConfigData config;
-    
-    auto get_string = [&](const std::string& key) -> std::optional<std::string> {
-        std::string value = extract_json_value(json_str, key);
-        return value.empty() ? std::nullopt : std::make_optional(value);
+
+    // Single forward pass over the buffer: each iteration consumes one
+    // "key": value pair and dispatches it into ConfigData. Key and value
+    // stay as views into the (possibly memory-mapped) buffer; we only
+    // allocate when a recognized value is materialized into the struct.
+    // The config is a flat object, so no nesting support is needed.
+    size_t pos = 0;
+
+    auto skip_ws = [&]() {
+        while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) ++pos;
     };
-    
-    auto get_bool = [&](const std::string& key) -> std::optional<bool> {
-        std::string value = extract_json_value(json_str, key);
-        if (value == "true") return true;
-        if (value == "false") return false;
+
+    // Closing quote of a string whose opening quote is just before `from`,
+    // honoring backslash escapes
+    auto find_string_end = [&](size_t from) -> size_t {
+        for (size_t i = from; i < json.size(); ++i) {
+            if (json[i] == '\\') { ++i; continue; }
+            if (json[i] == '"') return i;
+        }
+        return std::string_view::npos;
+    };
+
+    std::string_view raw; // current raw value token
+
+    auto get_string = [&]() -> std::optional<std::string> {
+        return raw.empty() ? std::nullopt : std::make_optional(materialize_string(raw));
+    };
+
+    auto get_bool = [&]() -> std::optional<bool> {
+        if (raw == "true") return true;
+        if (raw == "false") return false;
         return std::nullopt;
     };
-    
-    auto get_int = [&](const std::string& key) -> std::optional<int> {
-        std::string value = extract_json_value(json_str, key);
-        if (value.empty()) return std::nullopt;
-        try {
-            return std::stoi(value);
-        } catch (...) {
-            return std::nullopt;
-        }
+
+    auto get_int = [&]() -> std::optional<int> {
+        return parse_int_token(raw);
     };
-    
-    auto get_float = [&](const std::string& key) -> std::optional<float> {
-        std::string value = extract_json_value(json_str, key);
-        if (value.empty()) return std::nullopt;
-        try {
-            return std::stof(value);
-        } catch (...) {
-            return std::nullopt;
-        }
+
+    auto get_float = [&]() -> std::optional<float> {
+        return parse_float_token(raw);
     };
-    
-    config.default_model = get_string("default_model");
-    config.models_directory = get_string("models_directory");
-    config.use_coreml = get_bool("use_coreml");
-    config.coreml_no_ane = get_bool("coreml_no_ane");
-    config.coreml_model = get_string("coreml_model");
-    config.capture_device = get_int("capture_device");
-    config.step_ms = get_int("step_ms");
-    config.length_ms = get_int("length_ms");
-    config.keep_ms = get_int("keep_ms");
-    config.vad_threshold = get_float("vad_threshold");
-    config.freq_threshold = get_float("freq_threshold");
-    config.threads = get_int("threads");
-    config.max_tokens = get_int("max_tokens");
-    config.beam_size = get_int("beam_size");
-    config.language = get_string("language");
-    config.translate = get_bool("translate");
-    config.no_timestamps = get_bool("no_timestamps");
-    config.print_special = get_bool("print_special");
-    config.print_colors = get_bool("print_colors");
-    config.save_audio = get_bool("save_audio");
-    config.tinydiarize = get_bool("tinydiarize");
-    config.output_file = get_string("output_file");
-    config.output_format = get_string("output_format");
-    config.output_mode = get_string("output_mode");
-    
-    // Auto-copy settings
-    config.auto_copy_enabled = get_bool("auto_copy_enabled");
-    config.auto_copy_max_duration_hours = get_int("auto_copy_max_duration_hours");
-    config.auto_copy_max_size_bytes = get_int("auto_copy_max_size_bytes");
 
-    // Meeting settings
-    config.meeting_mode = get_bool("meeting_mode");
-    config.meeting_prompt = get_string("meeting_prompt");
-    config.meeting_name = get_string("meeting_name");
-    config.meeting_initial_prompt = get_string("meeting_initial_prompt");
-    config.meeting_timeout = get_int("meeting_timeout");
-    config.meeting_max_single_pass = get_int("meeting_max_single_pass");
-    config.silence_timeout = get_float("silence_timeout");
+    while (pos < json.size()) {
+        pos = json.find('"', pos);
+        if (pos == std::string_view::npos) break;
 
-    // Push-to-talk settings
-    config.ptt_mode = get_bool("ptt_mode");
-    config.ptt_key = get_string("ptt_key");
+        size_t key_end = find_string_end(pos + 1);
+        if (key_end == std::string_view::npos) break;
+        std::string_view key = json.substr(pos + 1, key_end - pos - 1);
+        pos = key_end + 1;
 
-    // Refinement settings
-    config.refine = get_bool("refine");
-    config.history_enabled = get_bool("history_enabled");
+        skip_ws();
+        if (pos >= json.size() || json[pos] != ':') continue; // stray string, not a key
+        ++pos;
+        skip_ws();
+        if (pos >= json.size()) break;
 
-    // Accuracy settings
-    config.entropy_thold = get_float("entropy_thold");
-    config.logprob_thold = get_float("logprob_thold");
-    config.no_speech_thold = get_float("no_speech_thold");
-    config.length_penalty = get_float("length_penalty");
-    config.best_of = get_int("best_of");
-    config.suppress_nst = get_bool("suppress_nst");
-    config.carry_initial_prompt = get_bool("carry_initial_prompt");
-    config.normalize_audio = get_bool("normalize_audio");
+        if (json[pos] == '"') {
+            // String value
+            size_t end = find_string_end(pos + 1);
+            if (end == std::string_view::npos) break;
+            raw = json.substr(pos + 1, end - pos - 1);
+            pos = end + 1;
+        } else {
+            // Non-string value (number, boolean, null)
+            size_t end = pos;
+            while (end < json.size() && json[end] != ',' && json[end] != '}' && json[end] != ']') {
+                ++end;
+            }
+            raw = json.substr(pos, end - pos);
+            while (!raw.empty() && std::isspace(static_cast<unsigned char>(raw.back()))) {
+                raw.remove_suffix(1);
+            }
+            pos = end;
+        }
+
+        // Model settings
+        if (key == "default_model") config.default_model = get_string();
+        else if (key == "models_directory") config.models_directory = get_string();
+        else if (key == "use_coreml") config.use_coreml = get_bool();
+        else if (key == "coreml_no_ane") config.coreml_no_ane = get_bool();
+        else if (key == "coreml_model") config.coreml_model = get_string();
+
+        // Audio settings
+        else if (key == "capture_device") config.capture_device = get_int();
+        else if (key == "step_ms") config.step_ms = get_int();
+        else if (key == "length_ms") config.length_ms = get_int();
+        else if (key == "keep_ms") config.keep_ms = get_int();
+        else if (key == "vad_threshold") config.vad_threshold = get_float();
+        else if (key == "freq_threshold") config.freq_threshold = get_float();
+
+        // Processing settings
+        else if (key == "threads") config.threads = get_int();
+        else if (key == "max_tokens") config.max_tokens = get_int();
+        else if (key == "beam_size") config.beam_size = get_int();
+        else if (key == "language") config.language = get_string();
+        else if (key == "translate") config.translate = get_bool();
+        else if (key == "no_timestamps") config.no_timestamps = get_bool();
+        else if (key == "print_special") config.print_special = get_bool();
+        else if (key == "print_colors") config.print_colors = get_bool();
+        else if (key == "save_audio") config.save_audio = get_bool();
+        else if (key == "tinydiarize") config.tinydiarize = get_bool();
+
+        // Output settings
+        else if (key == "output_file") config.output_file = get_string();
+        else if (key == "output_format") config.output_format = get_string();
+        else if (key == "output_mode") config.output_mode = get_string();
+
+        // Auto-copy settings
+        else if (key == "auto_copy_enabled") config.auto_copy_enabled = get_bool();
+        else if (key == "auto_copy_max_duration_hours") config.auto_copy_max_duration_hours = get_int();
+        else if (key == "auto_copy_max_size_bytes") config.auto_copy_max_size_bytes = get_int();
+
+        // Meeting settings
+        else if (key == "meeting_mode") config.meeting_mode = get_bool();
+        else if (key == "meeting_prompt") config.meeting_prompt = get_string();
+        else if (key == "meeting_name") config.meeting_name = get_string();
+        else if (key == "meeting_initial_prompt") config.meeting_initial_prompt = get_string();
+        else if (key == "meeting_timeout") config.meeting_timeout = get_int();
+        else if (key == "meeting_max_single_pass") config.meeting_max_single_pass = get_int();
+        else if (key == "silence_timeout") config.silence_timeout = get_float();
+
+        // Push-to-talk settings
+        else if (key == "ptt_mode") config.ptt_mode = get_bool();
+        else if (key == "ptt_key") config.ptt_key = get_string();
+
+        // Refinement settings
+        else if (key == "refine") config.refine = get_bool();
+        else if (key == "history_enabled") config.history_enabled = get_bool();
+
+        // Accuracy settings
+        else if (key == "entropy_thold") config.entropy_thold = get_float();
+        else if (key == "logprob_thold") config.logprob_thold = get_float();
+        else if (key == "no_speech_thold") config.no_speech_thold = get_float();
+        else if (key == "length_penalty") config.length_penalty = get_float();
+        else if (key == "best_of") config.best_of = get_int();
+        else if (key == "suppress_nst") config.suppress_nst = get_bool();
+        else if (key == "carry_initial_prompt") config.carry_initial_prompt = get_bool();
+        else if (key == "normalize_audio") config.normalize_audio = get_bool();
+    }
 
     return config;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
 #include <optional>
 #include <vector>
@@ -122,7 +123,7 @@ private:
     
     // JSON serialization
     std::string config_to_json(const ConfigData& config) const;
-    ConfigData json_to_config(const std::string& json_str) const;
+    ConfigData json_to_config(std::string_view json) const;
     
     // Environment variable helpers
     std::optional<std::string> get_env_var(const std::string& name) const;
@@ -1,4 +1,5 @@
 #include "export_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -114,6 +115,7 @@ std::string ExportManager::get_export_string(ExportFormat format) {
         case ExportFormat::SRT:      return export_srt();
         case ExportFormat::VTT:      return export_vtt();
         case ExportFormat::XML:      return export_xml();
+        case ExportFormat::JSONL:    return export_jsonl();
         default:                     return export_txt();
     }
 }
@@ -133,26 +135,8 @@ std::string ExportManager::export_txt() {
         output << "\n" << std::string(50, '-') << "\n\n";
     }
     
-    for (const auto& segment : segments_) {
-        if (include_timestamps_) {
-            output << "[" << format_timestamp(segment.start_time_ms) 
-                   << " --> " << format_timestamp(segment.end_time_ms) << "] ";
-        }
-        
-        output << segment.text;
-        
-        if (include_confidence_) {
-            output << " (confidence: " << std::fixed << std::setprecision(2) 
-                   << segment.confidence << ")";
-        }
-        
-        if (segment.speaker_id >= 0) {
-            output << " [Speaker " << segment.speaker_id << "]";
-        } else if (segment.speaker_turn) {
-            output << " [SPEAKER_TURN]";
-        }
-
-        output << "\n";
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        output << render_segment(ExportFormat::TXT, segments_[i], i);
     }
 
     return output.str();
@@ -180,29 +164,9 @@ std::string ExportManager::export_markdown() {
     }
     
     for (size_t i = 0; i < segments_.size(); ++i) {
-        const auto& segment = segments_[i];
-        
-        if (include_timestamps_) {
-            output << "**[" << format_timestamp(segment.start_time_ms) 
-                   << " → " << format_timestamp(segment.end_time_ms) << "]** ";
-        }
-        
-        output << segment.text;
-        
-        if (include_confidence_) {
-            output << " *(confidence: " << std::fixed << std::setprecision(2) 
-                   << segment.confidence << ")*";
-        }
-        
-        if (segment.speaker_id >= 0) {
-            output << " **[Speaker " << segment.speaker_id << "]**";
-        } else if (segment.speaker_turn) {
-            output << " `[SPEAKER_TURN]`";
-        }
-
-        output << "\n\n";
+        output << render_segment(ExportFormat::MARKDOWN, segments_[i], i);
     }
-    
+
     output << "---\n";
     output << "*Generated by recognize v" << metadata_.version << "*\n";
     
@@ -274,22 +238,9 @@ std::string ExportManager::export_csv() {
     output << ",speaker_turn\n";
     
     for (size_t i = 0; i < segments_.size(); ++i) {
-        const auto& segment = segments_[i];
-        
-        output << i << ","
-               << segment.start_time_ms << ","
-               << segment.end_time_ms << ","
-               << "\"" << format_timestamp(segment.start_time_ms) << "\","
-               << "\"" << format_timestamp(segment.end_time_ms) << "\","
-               << "\"" << escape_csv_field(segment.text) << "\"";
-        
-        if (include_confidence_) {
-            output << "," << segment.confidence;
-        }
-        
-        output << "," << (segment.speaker_turn ? "true" : "false") << "\n";
+        output << render_segment(ExportFormat::CSV, segments_[i], i);
     }
-    
+
     return output.str();
 }
 
@@ -297,19 +248,9 @@ std::string ExportManager::export_srt() {
     std::ostringstream output;
     
     for (size_t i = 0; i < segments_.size(); ++i) {
-        const auto& segment = segments_[i];
-        
-        output << (i + 1) << "\n";
-        output << format_timestamp(segment.start_time_ms, true) 
-               << " --> " 
-               << format_timestamp(segment.end_time_ms, true) << "\n";
-        output << segment.text;
-        if (segment.speaker_turn) {
-            output << " [SPEAKER_TURN]";
-        }
-        output << "\n\n";
+        output << render_segment(ExportFormat::SRT, segments_[i], i);
     }
-    
+
     return output.str();
 }
 
@@ -325,17 +266,120 @@ std::string ExportManager::export_vtt() {
         output << "Model: " << metadata_.model_name << "\n\n";
     }
     
-    for (const auto& segment : segments_) {
-        output << format_timestamp(segment.start_time_ms) 
-               << " --> " 
-               << format_timestamp(segment.end_time_ms) << "\n";
-        output << segment.text;
-        if (segment.speaker_turn) {
-            output << " [SPEAKER_TURN]";
-        }
-        output << "\n\n";
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        output << render_segment(ExportFormat::VTT, segments_[i], i);
     }
-    
+
+    return output.str();
+}
+
+std::string ExportManager::export_jsonl() {
+    std::ostringstream output;
+
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        output << render_segment(ExportFormat::JSONL, segments_[i], i);
+    }
+
+    return output.str();
+}
+
+std::string ExportManager::render_segment(ExportFormat format, const TranscriptionSegment& segment, size_t index) {
+    std::ostringstream output;
+
+    switch (format) {
+        case ExportFormat::TXT:
+            if (include_timestamps_) {
+                output << "[" << format_timestamp(segment.start_time_ms)
+                       << " --> " << format_timestamp(segment.end_time_ms) << "] ";
+            }
+            output << segment.text;
+            if (include_confidence_) {
+                output << " (confidence: " << std::fixed << std::setprecision(2)
+                       << segment.confidence << ")";
+            }
+            if (segment.speaker_id >= 0) {
+                output << " [Speaker " << segment.speaker_id << "]";
+            } else if (segment.speaker_turn) {
+                output << " [SPEAKER_TURN]";
+            }
+            output << "\n";
+            break;
+
+        case ExportFormat::MARKDOWN:
+            if (include_timestamps_) {
+                output << "**[" << format_timestamp(segment.start_time_ms)
+                       << " → " << format_timestamp(segment.end_time_ms) << "]** ";
+            }
+            output << segment.text;
+            if (include_confidence_) {
+                output << " *(confidence: " << std::fixed << std::setprecision(2)
+                       << segment.confidence << ")*";
+            }
+            if (segment.speaker_id >= 0) {
+                output << " **[Speaker " << segment.speaker_id << "]**";
+            } else if (segment.speaker_turn) {
+                output << " `[SPEAKER_TURN]`";
+            }
+            output << "\n\n";
+            break;
+
+        case ExportFormat::CSV:
+            output << index << ","
+                   << segment.start_time_ms << ","
+                   << segment.end_time_ms << ","
+                   << "\"" << format_timestamp(segment.start_time_ms) << "\","
+                   << "\"" << format_timestamp(segment.end_time_ms) << "\","
+                   << "\"" << escape_csv_field(segment.text) << "\"";
+            if (include_confidence_) {
+                output << "," << segment.confidence;
+            }
+            output << "," << (segment.speaker_turn ? "true" : "false") << "\n";
+            break;
+
+        case ExportFormat::SRT:
+            output << (index + 1) << "\n";
+            output << format_timestamp(segment.start_time_ms, true)
+                   << " --> "
+                   << format_timestamp(segment.end_time_ms, true) << "\n";
+            output << segment.text;
+            if (segment.speaker_turn) {
+                output << " [SPEAKER_TURN]";
+            }
+            output << "\n\n";
+            break;
+
+        case ExportFormat::VTT:
+            output << format_timestamp(segment.start_time_ms)
+                   << " --> "
+                   << format_timestamp(segment.end_time_ms) << "\n";
+            output << segment.text;
+            if (segment.speaker_turn) {
+                output << " [SPEAKER_TURN]";
+            }
+            output << "\n\n";
+            break;
+
+        case ExportFormat::JSONL:
+            output << "{\"id\":" << index
+                   << ",\"start_time_ms\":" << segment.start_time_ms
+                   << ",\"end_time_ms\":" << segment.end_time_ms
+                   << ",\"text\":\"" << escape_json_string(segment.text) << "\"";
+            if (include_confidence_) {
+                output << ",\"confidence\":" << segment.confidence;
+            }
+            if (segment.speaker_id >= 0) {
+                output << ",\"speaker_id\":" << segment.speaker_id;
+            }
+            if (segment.speaker_turn) {
+                output << ",\"speaker_turn\":true";
+            }
+            output << "}\n";
+            break;
+
+        default:
+            break;
+    }
+
     return output.str();
 }
 
@@ -383,6 +427,114 @@ std::string ExportManager::export_xml() {
     return output.str();
 }
 
+bool ExportManager::format_supports_streaming(ExportFormat format) {
+    // JSON and XML need a closing document structure — appending segments
+    // would leave an invalid file if the session crashes mid-way
+    return format != ExportFormat::JSON && format != ExportFormat::XML;
+}
+
+bool ExportManager::stream_begin() {
+    if (!format_supports_streaming(format_)) {
+        return false;
+    }
+
+    std::string filename = auto_filename_ ? generate_filename(format_) : output_file_;
+    stream_.open(filename, std::ios::out | std::ios::trunc);
+    if (!stream_.is_open()) {
+        std::cerr << "❌ Failed to open file for streaming export: " << filename << std::endl;
+        return false;
+    }
+
+    stream_file_ = filename;
+    stream_count_ = 0;
+    stream_first_ms_ = -1;
+    stream_last_ms_ = 0;
+
+    // Header only — duration and segment count aren't known yet
+    switch (format_) {
+        case ExportFormat::TXT:
+            if (include_metadata_) {
+                stream_ << "# Transcription Export\n";
+                stream_ << "Session ID: " << metadata_.session_id << "\n";
+                stream_ << "Date: " << get_current_timestamp() << "\n";
+                stream_ << "Model: " << metadata_.model_name << "\n";
+                stream_ << "Language: " << metadata_.language << "\n";
+                stream_ << "\n" << std::string(50, '-') << "\n\n";
+            }
+            break;
+        case ExportFormat::MARKDOWN:
+            stream_ << "# Transcription Export\n\n";
+            if (include_metadata_) {
+                stream_ << "## Session Information\n\n";
+                stream_ << "| Field | Value |\n";
+                stream_ << "|-------|-------|\n";
+                stream_ << "| Session ID | `" << metadata_.session_id << "` |\n";
+                stream_ << "| Date | " << get_current_timestamp() << " |\n";
+                stream_ << "| Model | " << metadata_.model_name << " |\n";
+                stream_ << "| Language | " << metadata_.language << " |\n";
+                stream_ << "| CoreML | " << (metadata_.coreml_enabled ? "Enabled" : "Disabled") << " |\n";
+                stream_ << "| VAD Threshold | " << metadata_.vad_threshold << " |\n";
+                stream_ << "\n## Transcription\n\n";
+            }
+            break;
+        case ExportFormat::CSV:
+            stream_ << "id,start_time_ms,end_time_ms,start_time,end_time,text";
+            if (include_confidence_) stream_ << ",confidence";
+            stream_ << ",speaker_turn\n";
+            break;
+        case ExportFormat::VTT:
+            stream_ << "WEBVTT\n\n";
+            if (include_metadata_) {
+                stream_ << "NOTE\n";
+                stream_ << "Generated by recognize v" << metadata_.version << "\n";
+                stream_ << "Session: " << metadata_.session_id << "\n";
+                stream_ << "Model: " << metadata_.model_name << "\n\n";
+            }
+            break;
+        default: // SRT and JSONL have no header
+            break;
+    }
+
+    stream_.flush();
+    return true;
+}
+
+bool ExportManager::stream_segment(const TranscriptionSegment& segment) {
+    if (!stream_.is_open()) {
+        return false;
+    }
+
+    stream_ << render_segment(format_, segment, stream_count_);
+    stream_.flush();
+
+    if (stream_first_ms_ < 0) stream_first_ms_ = segment.start_time_ms;
+    stream_last_ms_ = segment.end_time_ms;
+    ++stream_count_;
+
+    return stream_.good();
+}
+
+bool ExportManager::stream_end() {
+    if (!stream_.is_open()) {
+        return false;
+    }
+
+    if (format_ == ExportFormat::MARKDOWN) {
+        stream_ << "---\n";
+        stream_ << "*Generated by recognize v" << metadata_.version << "*\n";
+    }
+
+    stream_.close();
+
+    double duration_s = stream_first_ms_ >= 0 ? (stream_last_ms_ - stream_first_ms_) / 1000.0 : 0.0;
+    std::cout << "✅ Transcription exported to: " << stream_file_ << std::endl;
+    std::cout << "📊 " << stream_count_ << " segments, "
+              << std::fixed << std::setprecision(1)
+              << duration_s << " seconds" << std::endl;
+
+    return true;
+}
+
 std::string ExportManager::format_timestamp(int64_t ms, bool srt_format) {
     int64_t total_seconds = ms / 1000;
     int64_t milliseconds = ms % 1000;
@@ -470,6 +622,7 @@ std::string ExportManager::format_to_extension(ExportFormat format) {
         case ExportFormat::SRT:      return ".srt";
         case ExportFormat::VTT:      return ".vtt";
         case ExportFormat::XML:      return ".xml";
+        case ExportFormat::JSONL:    return ".jsonl";
         default:                     return ".txt";
     }
 }
@@ -485,12 +638,13 @@ ExportFormat ExportManager::extension_to_format(const std::string& extension) {
     if (ext == ".srt") return ExportFormat::SRT;
     if (ext == ".vtt") return ExportFormat::VTT;
     if (ext == ".xml") return ExportFormat::XML;
-    
+    if (ext == ".jsonl") return ExportFormat::JSONL;
+
     return ExportFormat::TXT; // Default
 }
 
 std::vector<std::string> ExportManager::get_supported_formats() {
-    return {"txt", "md", "json", "csv", "srt", "vtt", "xml"};
+    return {"txt", "md", "json", "csv", "srt", "vtt", "xml", "jsonl"};
 }
 
 std::string ExportManager::generate_filename(ExportFormat format) {
@@ -12,7 +12,8 @@ enum class ExportFormat {
     CSV,        // Comma-separated values
     SRT,        // SubRip subtitle format
     VTT,        // WebVTT subtitle format
-    XML         // XML format
+    XML,        // XML format
+    JSONL       // JSON Lines (one segment object per line)
 };
 
 struct TranscriptionSegment {
@@ -65,7 +66,17 @@ public:
     bool export_transcription();
     bool export_to_file(const std::string& filename, ExportFormat format);
     std::string get_export_string(ExportFormat format);
-    
+
+    // Streaming export: open the file at session start, append each segment
+    // as it's finalized, write only the footer at close — constant memory
+    // and crash-safe (everything streamed so far survives a crash).
+    // JSON and XML need a closing document structure and are not streamable.
+    bool stream_begin();
+    bool stream_segment(const TranscriptionSegment& segment);
+    bool stream_end();
+    bool is_streaming() const { return stream_.is_open(); }
+    static bool format_supports_streaming(ExportFormat format);
+
     // Utility functions
     static std::string format_to_extension(ExportFormat format);
     static ExportFormat extension_to_format(const std::string& extension);
@@ -87,7 +98,14 @@ private:
     
     std::vector<TranscriptionSegment> segments_;
     SessionMetadata metadata_;
-    
+
+    // Streaming state
+    std::ofstream stream_;
+    std::string stream_file_;
+    size_t stream_count_ = 0;
+    int64_t stream_first_ms_ = -1;
+    int64_t stream_last_ms_ = 0;
+
     // Format-specific export functions
     std::string export_txt();
     std::string export_markdown();
@@ -96,7 +114,12 @@ private:
     std::string export_srt();
     std::string export_vtt();
     std::string export_xml();
-    
+    std::string export_jsonl();
+
+    // One segment rendered in the given format — shared between the bulk
+    // exporters and the streaming path so their output stays identical
+    std::string render_segment(ExportFormat format, const TranscriptionSegment& segment, size_t index);
+
     // Utility functions
     std::string format_timestamp(int64_t ms, bool srt_format = false);
     std::string escape_json_string(const std::string& str);
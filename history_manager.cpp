@@ -6,9 +6,13 @@
 #include <sstream>
 #include <cstdlib>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iomanip>
 #include <ctime>
 #include <cmath>
+#include <mutex>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -108,6 +112,11 @@ bool HistoryManager::ensure_schema() {
             text       TEXT NOT NULL
         );
         CREATE INDEX IF NOT EXISTS idx_transcripts_ts ON transcripts(timestamp DESC);
+        CREATE INDEX IF NOT EXISTS idx_transcripts_mode ON transcripts(mode, timestamp DESC);
+        CREATE TABLE IF NOT EXISTS meta (
+            key   TEXT PRIMARY KEY,
+            value TEXT
+        );
     )";
 
     char* err = nullptr;
@@ -118,10 +127,13 @@ bool HistoryManager::ensure_schema() {
         return false;
     }
 
-    // FTS5 — optional, gracefully degrade to LIKE search if unavailable
+    // FTS5 — optional, gracefully degrade to LIKE search if unavailable.
+    // prefix indexes make "query*" as-you-type searches index-backed
+    // (existing DBs keep their old table until `history reindex` is run)
     const char* fts_sql = R"(
         CREATE VIRTUAL TABLE IF NOT EXISTS transcripts_fts USING fts5(
-            text, content='transcripts', content_rowid='id', tokenize='porter unicode61'
+            text, content='transcripts', content_rowid='id', tokenize='porter unicode61',
+            prefix='2 3'
         );
         CREATE TRIGGER IF NOT EXISTS tr_ai AFTER INSERT ON transcripts BEGIN
             INSERT INTO transcripts_fts(rowid, text) VALUES (new.id, new.text);
@@ -182,14 +194,150 @@ int64_t HistoryManager::save(const std::string& text, double duration_s,
     }
 
     int64_t row_id = sqlite3_last_insert_rowid(db_);
-    auto_prune();
     return row_id;
 }
 
+// ---------------------------------------------------------------------------
+// Async write queue
+// ---------------------------------------------------------------------------
+//
+// Opening the database, inserting, and pruning costs 100-300ms on a large
+// history DB — pure dead time when it runs synchronously on the auto-stop
+// exit path. queue_save() hands the entry to a lazily started background
+// writer (which also prunes opportunistically once the queue drains);
+// flush_async() bounds the wait at exit so a slow disk can't hang shutdown.
+
+namespace {
+
+struct PendingSave {
+    std::string text;
+    double duration_s;
+    std::string model;
+    std::string mode;
+};
+
+std::mutex g_writer_mutex;
+std::condition_variable g_writer_cv;
+std::deque<PendingSave> g_writer_queue;
+std::thread g_writer_thread;
+bool g_writer_started = false;
+bool g_writer_stopping = false;
+int g_writer_pending = 0; // queued + in-flight entries
+
+void history_writer_main() {
+    HistoryManager history;
+    const bool opened = history.open();
+    bool pruned = false;
+
+    for (;;) {
+        PendingSave item;
+        {
+            std::unique_lock<std::mutex> lock(g_writer_mutex);
+            g_writer_cv.wait(lock, [] {
+                return !g_writer_queue.empty() || g_writer_stopping;
+            });
+            if (g_writer_queue.empty()) {
+                break;
+            }
+            item = std::move(g_writer_queue.front());
+            g_writer_queue.pop_front();
+        }
+
+        if (opened) {
+            history.save(item.text, item.duration_s, item.model, item.mode);
+            if (!pruned) {
+                // Deferred pruning: once per process, off the save path, and
+                // the last_pruned marker keeps it to at most once a day
+                history.prune_if_due();
+                pruned = true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_writer_mutex);
+            --g_writer_pending;
+        }
+        g_writer_cv.notify_all();
+    }
+}
+
+} // namespace
+
+void HistoryManager::queue_save(const std::string& text, double duration_s,
+                                const std::string& model, const std::string& mode) {
+    if (text.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_writer_mutex);
+        if (g_writer_stopping) {
+            return;
+        }
+        if (!g_writer_started) {
+            g_writer_thread = std::thread(history_writer_main);
+            g_writer_started = true;
+        }
+        g_writer_queue.push_back({text, duration_s, model, mode});
+        ++g_writer_pending;
+    }
+    g_writer_cv.notify_all();
+}
+
+void HistoryManager::flush_async(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(g_writer_mutex);
+    if (!g_writer_started) {
+        return;
+    }
+
+    const bool drained = g_writer_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                              [] { return g_writer_pending == 0; });
+    g_writer_stopping = true;
+    lock.unlock();
+    g_writer_cv.notify_all();
+
+    if (drained) {
+        g_writer_thread.join();
+    } else {
+        // Slow disk: don't hang shutdown — WAL keeps the DB consistent
+        // even if the process exits while the write is in flight
+        g_writer_thread.detach();
+        std::cerr << "[history] background save still running at exit\n";
+    }
+}
+
 // ---------------------------------------------------------------------------
 // auto_prune
 // ---------------------------------------------------------------------------
 
+void HistoryManager::prune() {
+    auto_prune();
+}
+
+void HistoryManager::prune_if_due() {
+    if (db_ == nullptr) {
+        return;
+    }
+
+    // Deletes against a 40k-entry table cost hundreds of ms even with the
+    // timestamp index, so pruning runs at most daily — the last_pruned
+    // marker in meta gates it. `history prune` (or prune()) bypasses this.
+    const char* check_sql =
+        "SELECT 1 FROM meta WHERE key = 'last_pruned' AND "
+        "value > strftime('%Y-%m-%dT%H:%M:%S', 'now', 'localtime', '-1 days');";
+    sqlite3_stmt* stmt = nullptr;
+    bool fresh = false;
+    if (sqlite3_prepare_v2(db_, check_sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        fresh = (sqlite3_step(stmt) == SQLITE_ROW);
+        sqlite3_finalize(stmt);
+    }
+    if (fresh) {
+        return;
+    }
+
+    auto_prune();
+}
+
 void HistoryManager::auto_prune() {
     if (db_ == nullptr) {
         return;
@@ -217,21 +365,30 @@ void HistoryManager::auto_prune() {
         sqlite3_step(stmt);
         sqlite3_finalize(stmt);
     }
+
+    // Stamp the marker so prune_if_due() skips until tomorrow
+    sqlite3_exec(db_,
+        "INSERT OR REPLACE INTO meta(key, value) VALUES('last_pruned', "
+        "strftime('%Y-%m-%dT%H:%M:%S', 'now', 'localtime'));",
+        nullptr, nullptr, nullptr);
 }
 
 // ---------------------------------------------------------------------------
 // list
 // ---------------------------------------------------------------------------
 
-std::vector<HistoryManager::Entry> HistoryManager::list(int limit, int offset) {
+std::vector<HistoryManager::Entry> HistoryManager::list(int limit, int64_t before_id) {
     std::vector<Entry> results;
     if (db_ == nullptr) {
         return results;
     }
 
+    // Keyset pagination: OFFSET re-scans everything it skips, so paging
+    // deep into a 40k-entry table degrades linearly. Paging by "rows older
+    // than the last id seen" stays a primary-key range scan at any depth.
     const char* sql =
         "SELECT id, timestamp, duration_s, model, mode, word_count, text "
-        "FROM transcripts ORDER BY timestamp DESC LIMIT ? OFFSET ?;";
+        "FROM transcripts WHERE (?1 = 0 OR id < ?1) ORDER BY id DESC LIMIT ?2;";
 
     sqlite3_stmt* stmt = nullptr;
     if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
@@ -239,8 +396,8 @@ std::vector<HistoryManager::Entry> HistoryManager::list(int limit, int offset) {
         return results;
     }
 
-    sqlite3_bind_int(stmt, 1, limit);
-    sqlite3_bind_int(stmt, 2, offset);
+    sqlite3_bind_int64(stmt, 1, before_id);
+    sqlite3_bind_int(stmt, 2, limit);
 
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         Entry e;
@@ -262,6 +419,26 @@ std::vector<HistoryManager::Entry> HistoryManager::list(int limit, int offset) {
 // search
 // ---------------------------------------------------------------------------
 
+// "hello wor" → "\"hello\"* \"wor\"*" — quoted prefix tokens, so raw user
+// input can't break FTS5 query syntax and partial words match as-you-type
+static std::string fts_prefix_query(const std::string& query) {
+    std::string match;
+    std::istringstream ss(query);
+    std::string token;
+    while (ss >> token) {
+        std::string clean;
+        for (char c : token) {
+            if (c != '"') clean += c;
+        }
+        if (clean.empty()) {
+            continue;
+        }
+        if (!match.empty()) match += " ";
+        match += "\"" + clean + "\"*";
+    }
+    return match;
+}
+
 std::vector<HistoryManager::Entry> HistoryManager::search(
         const std::string& query, int limit, const std::string& since) {
     std::vector<Entry> results;
@@ -271,6 +448,10 @@ std::vector<HistoryManager::Entry> HistoryManager::search(
 
     std::string sql;
     std::string like_query = "%" + query + "%";
+    std::string fts_query = fts_prefix_query(query);
+    if (has_fts_ && fts_query.empty()) {
+        return results;
+    }
 
     if (has_fts_) {
         if (since.empty()) {
@@ -315,7 +496,7 @@ std::vector<HistoryManager::Entry> HistoryManager::search(
         return results;
     }
 
-    const std::string& bind_val = has_fts_ ? query : like_query;
+    const std::string& bind_val = has_fts_ ? fts_query : like_query;
     sqlite3_bind_text(stmt, 1, bind_val.c_str(), -1, SQLITE_TRANSIENT);
     if (since.empty()) {
         sqlite3_bind_int(stmt, 2, limit);
@@ -422,6 +603,47 @@ int HistoryManager::clear_all() {
     return deleted;
 }
 
+// ---------------------------------------------------------------------------
+// reindex
+// ---------------------------------------------------------------------------
+
+bool HistoryManager::reindex() {
+    if (db_ == nullptr) {
+        return false;
+    }
+
+    // Recreate the FTS table so DBs created before the prefix-index config
+    // pick it up, then rebuild it from the content table
+    const char* drop_sql =
+        "DROP TRIGGER IF EXISTS tr_ai;"
+        "DROP TRIGGER IF EXISTS tr_ad;"
+        "DROP TABLE IF EXISTS transcripts_fts;";
+
+    char* err = nullptr;
+    if (sqlite3_exec(db_, drop_sql, nullptr, nullptr, &err) != SQLITE_OK) {
+        std::cerr << "[history] reindex error: " << (err ? err : "unknown") << "\n";
+        sqlite3_free(err);
+        return false;
+    }
+
+    has_fts_ = false;
+    if (!ensure_schema() || !has_fts_) {
+        return false;
+    }
+
+    err = nullptr;
+    if (sqlite3_exec(db_,
+            "INSERT INTO transcripts_fts(transcripts_fts) VALUES('rebuild');"
+            "INSERT INTO transcripts_fts(transcripts_fts) VALUES('optimize');",
+            nullptr, nullptr, &err) != SQLITE_OK) {
+        std::cerr << "[history] reindex error: " << (err ? err : "unknown") << "\n";
+        sqlite3_free(err);
+        return false;
+    }
+
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 // count
 // ---------------------------------------------------------------------------
@@ -19,6 +19,19 @@ public:
     int64_t save(const std::string& text, double duration_s,
                  const std::string& model, const std::string& mode);
 
+    // Async write path: hand the entry to a background writer thread and
+    // return immediately — keeps SQLite off the session exit path.
+    // flush_async() waits (bounded) for queued writes before process exit.
+    static void queue_save(const std::string& text, double duration_s,
+                           const std::string& model, const std::string& mode);
+    static void flush_async(int timeout_ms = 2000);
+
+    // Prune old/excess entries. prune() always runs (for `history prune` /
+    // cron); prune_if_due() honors the daily last_pruned marker and is what
+    // the background writer calls opportunistically.
+    void prune();
+    void prune_if_due();
+
     // Read
     struct Entry {
         int64_t id;
@@ -30,7 +43,9 @@ public:
         std::string text;
     };
 
-    std::vector<Entry> list(int limit = 20, int offset = 0);
+    // Keyset pagination: pass the smallest id from the previous page as
+    // before_id to fetch the next one (0 = newest page)
+    std::vector<Entry> list(int limit = 20, int64_t before_id = 0);
     std::vector<Entry> search(const std::string& query, int limit = 20,
                               const std::string& since = "");
     std::optional<Entry> get(int64_t id);
@@ -39,6 +54,7 @@ public:
     int clear_older_than(int days);
     int clear_all();
     int count();
+    bool reindex();
 
     // Output formatting
     static std::string format_table(const std::vector<Entry>& entries);
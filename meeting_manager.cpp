@@ -1,13 +1,16 @@
 #include "meeting_manager.h"
 #include "text_processing.h"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <random>
 #include <sstream>
+#include <thread>
 
 // Default meeting organization prompt
 const std::string DEFAULT_MEETING_PROMPT = R"(You are a senior executive assistant organizing a meeting transcription. Use ONLY content explicitly present in the transcript — do not infer, assume, or hallucinate details.
@@ -92,15 +95,30 @@ MeetingSession::MeetingSession() {
     std::uniform_int_distribution<> dis(100000, 999999);
     session_id = std::to_string(dis(gen));
     start_time = std::chrono::high_resolution_clock::now();
+    transcription_buffer.open("meeting-" + session_id);
 }
 
-void MeetingSession::add_transcription(const std::string& text, bool speaker_turn) {
+void MeetingSession::add_transcription(const std::string& text, bool speaker_turn, int channel) {
     // Label the very first speaker on the first call
     if (!first_text_added) {
         first_text_added = true;
-        transcription_buffer << "[Speaker 1] ";
+        last_channel = channel;
+        transcription_buffer << (channel == 1 ? "[Remote] " : "[Speaker 1] ");
+        transcription_buffer << text;
+        return;
     }
-    if (speaker_turn) {
+
+    // Dual-stream capture: a channel change re-labels the line. Remote
+    // segments are tagged [Remote] and never advance the local speaker ids;
+    // returning to the mic restores the current [Speaker N] label.
+    if (channel != last_channel) {
+        last_channel = channel;
+        if (channel == 1) {
+            transcription_buffer << "\n[Remote] ";
+        } else {
+            transcription_buffer << "\n[Speaker " << current_speaker_id << "] ";
+        }
+    } else if (speaker_turn && channel == 0) {
         current_speaker_id++;
         if (current_speaker_id > total_speakers) {
             total_speakers = current_speaker_id;
@@ -253,26 +271,65 @@ bool process_meeting_transcription(const std::string& transcription, const std::
         auto chunks = split_into_chunks(transcription, max_single_pass);
         std::cerr << "Split into " << chunks.size() << " chunks for processing." << std::endl;
 
-        // Pass 1: Extract structured data from each chunk
+        // Pass 1: Extract structured data from each chunk. The CLI calls
+        // are independent subprocesses, so run them through a bounded
+        // worker pool instead of serially — a 3-hour meeting drops from
+        // minutes of sequential calls to roughly the slowest chunk.
+        const int n_workers = static_cast<int>(std::min<size_t>(3, chunks.size()));
+        std::vector<std::string> chunk_extracts(chunks.size());
+        std::atomic<size_t> next_idx{0};
+        std::atomic<size_t> n_done{0};
+        std::mutex log_mutex;
+
+        auto extract_worker = [&]() {
+            while (true) {
+                const size_t idx = next_idx.fetch_add(1);
+                if (idx >= chunks.size()) break;
+
+                std::string chunk_prompt = "Extract the following from this meeting transcript chunk ("
+                    + std::to_string(idx + 1) + "/" + std::to_string(chunks.size())
+                    + "). Output as structured bullet points. Preserve [Speaker N] labels.\n\n"
+                    + "DECISIONS: List each decision with rationale.\n"
+                    + "ACTION ITEMS: List each task with owner and deadline.\n"
+                    + "TOPICS: List key discussion topics with 2-3 bullet points each.\n"
+                    + "KEY FACTS: Numbers, dates, names mentioned.\n\n"
+                    + chunks[idx];
+
+                // One retry — a transient CLI failure shouldn't demote the
+                // chunk to raw transcript in the merge pass
+                std::string chunk_result = invoke_claude_cli(chunk_prompt, timeout_seconds);
+                if (chunk_result.empty()) {
+                    chunk_result = invoke_claude_cli(chunk_prompt, timeout_seconds);
+                }
+                chunk_extracts[idx] = chunk_result;
+
+                const size_t done = n_done.fetch_add(1) + 1;
+                std::lock_guard<std::mutex> lock(log_mutex);
+                if (chunk_result.empty()) {
+                    std::cerr << "Warning: Failed to process chunk " << (idx + 1) << std::endl;
+                } else {
+                    std::cerr << "Processed chunk " << done << "/" << chunks.size() << std::endl;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(n_workers);
+        for (int i = 0; i < n_workers; i++) {
+            workers.emplace_back(extract_worker);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        // Join extracts in chunk order so the merge pass sees the meeting
+        // in sequence regardless of which worker finished first
         std::string combined_extracts;
         for (size_t idx = 0; idx < chunks.size(); idx++) {
-            std::cerr << "Processing chunk " << (idx + 1) << "/" << chunks.size() << "..." << std::endl;
-
-            std::string chunk_prompt = "Extract the following from this meeting transcript chunk ("
-                + std::to_string(idx + 1) + "/" + std::to_string(chunks.size())
-                + "). Output as structured bullet points. Preserve [Speaker N] labels.\n\n"
-                + "DECISIONS: List each decision with rationale.\n"
-                + "ACTION ITEMS: List each task with owner and deadline.\n"
-                + "TOPICS: List key discussion topics with 2-3 bullet points each.\n"
-                + "KEY FACTS: Numbers, dates, names mentioned.\n\n"
-                + chunks[idx];
-
-            std::string chunk_result = invoke_claude_cli(chunk_prompt, timeout_seconds);
-            if (chunk_result.empty()) {
-                std::cerr << "Warning: Failed to process chunk " << (idx + 1) << std::endl;
+            if (chunk_extracts[idx].empty()) {
                 combined_extracts += "\n## Chunk " + std::to_string(idx + 1) + " (raw):\n" + chunks[idx] + "\n";
             } else {
-                combined_extracts += "\n## Chunk " + std::to_string(idx + 1) + " extracts:\n" + chunk_result + "\n";
+                combined_extracts += "\n## Chunk " + std::to_string(idx + 1) + " extracts:\n" + chunk_extracts[idx] + "\n";
             }
         }
 
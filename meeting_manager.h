@@ -1,8 +1,9 @@
 #pragma once
 
+#include "transcript_journal.h"
+
 #include <chrono>
 #include <string>
-#include <sstream>
 
 // Default meeting prompt template
 extern const std::string DEFAULT_MEETING_PROMPT;
@@ -11,14 +12,16 @@ extern const std::string DEFAULT_MEETING_PROMPT;
 struct MeetingSession {
     std::string session_id;
     std::chrono::high_resolution_clock::time_point start_time;
-    std::ostringstream transcription_buffer;
+    TranscriptJournal transcription_buffer;
     int current_speaker_id = 1;
     int total_speakers = 1;
     bool first_text_added = false;
+    int last_channel = 0;  // channel of the previous segment (dual-stream capture)
 
     MeetingSession();
 
-    void add_transcription(const std::string& text, bool speaker_turn = false);
+    // channel: 0 = local mic (speaker-tracked), 1 = system audio ([Remote])
+    void add_transcription(const std::string& text, bool speaker_turn = false, int channel = 0);
     std::string get_transcription() const;
     double get_duration_minutes() const;
 };
@@ -4,15 +4,95 @@
 #include <filesystem>
 #include <system_error>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 #include <chrono>
 #include <set>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
 
-#ifdef __APPLE__
-#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
 #endif
 
+namespace {
+    // Parallel download tuning: files below the threshold (or servers
+    // without range support) use the plain single-stream curl path
+    constexpr uint64_t PARALLEL_MIN_BYTES = 100ull * 1024 * 1024;
+    constexpr uint64_t DOWNLOAD_PIECE_BYTES = 32ull * 1024 * 1024;
+    constexpr int DOWNLOAD_CONNECTIONS = 4;
+
+    // Sidecar manifest (<model>.partial) describing an in-flight download
+    // so an interrupted fetch resumes instead of starting over
+    struct DownloadManifest {
+        std::string url;
+        uint64_t size = 0;
+        uint64_t piece = 0;
+        std::vector<char> done; // one flag per piece
+    };
+
+    bool read_download_manifest(const std::string& path, DownloadManifest& m) {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::string tag;
+        while (file >> tag) {
+            if (tag == "url") file >> m.url;
+            else if (tag == "size") file >> m.size;
+            else if (tag == "piece") file >> m.piece;
+            else if (tag == "done") {
+                std::string flags;
+                file >> flags;
+                m.done.assign(flags.begin(), flags.end());
+            }
+        }
+        return !m.url.empty() && m.size > 0 && m.piece > 0 && !m.done.empty();
+    }
+
+    bool write_download_manifest(const std::string& path, const DownloadManifest& m) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) return false;
+        file << "url " << m.url << "\n";
+        file << "size " << m.size << "\n";
+        file << "piece " << m.piece << "\n";
+        file << "done " << std::string(m.done.begin(), m.done.end()) << "\n";
+        return file.good();
+    }
+
+    // Fetch [offset, offset+length) via a ranged curl stream and pwrite it
+    // into the preallocated file. Returns true only if every byte arrived.
+    bool fetch_piece(const std::string& url, int fd, uint64_t offset, uint64_t length) {
+        std::ostringstream cmd;
+        cmd << "curl -sfL -r " << offset << "-" << (offset + length - 1)
+            << " \"" << url << "\"";
+
+        FILE* pipe = popen(cmd.str().c_str(), "r");
+        if (!pipe) return false;
+
+        std::vector<char> buf(256 * 1024);
+        uint64_t got = 0;
+        bool write_ok = true;
+        size_t n;
+        while ((n = fread(buf.data(), 1, buf.size(), pipe)) > 0) {
+            if (got + n > length) { write_ok = false; break; } // server over-delivered
+            if (pwrite(fd, buf.data(), n, static_cast<off_t>(offset + got)) != static_cast<ssize_t>(n)) {
+                write_ok = false;
+                break;
+            }
+            got += n;
+        }
+        int status = pclose(pipe);
+        return write_ok && status == 0 && got == length;
+    }
+}
+
 ModelManager::ModelManager() {
     // Use global models directory if installed system-wide
     const char* home = getenv("HOME");
@@ -148,6 +228,65 @@ void ModelManager::init_model_registry() {
         1500,
         true
     };
+
+    // Quantized variants (q5_0/q8_0): roughly half the weight memory for a
+    // small accuracy cost. Quantization only touches the ggml weights, so
+    // each variant pairs with its parent model's CoreML encoder — the
+    // encoder runs fp16 on the ANE either way.
+    models_["medium.en-q5_0"] = {
+        "medium.en-q5_0",
+        "Medium English q5_0 (539 MB) - medium.en accuracy at a third of the memory",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium.en-q5_0.bin",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium.en-encoder.mlmodelc.zip",
+        "ggml-medium.en-q5_0.bin",
+        "ggml-medium.en-encoder.mlmodelc",
+        539,
+        false
+    };
+
+    models_["medium-q5_0"] = {
+        "medium-q5_0",
+        "Medium multilingual q5_0 (539 MB) - medium accuracy at a third of the memory",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium-q5_0.bin",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-medium-encoder.mlmodelc.zip",
+        "ggml-medium-q5_0.bin",
+        "ggml-medium-encoder.mlmodelc",
+        539,
+        true
+    };
+
+    models_["large-v3-q5_0"] = {
+        "large-v3-q5_0",
+        "Large v3 q5_0 (1.1 GB) - large-v3 accuracy at a third of the memory",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-q5_0.bin",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-encoder.mlmodelc.zip",
+        "ggml-large-v3-q5_0.bin",
+        "ggml-large-v3-encoder.mlmodelc",
+        1080,
+        true
+    };
+
+    models_["large-v3-turbo-q5_0"] = {
+        "large-v3-turbo-q5_0",
+        "Large v3 Turbo q5_0 (574 MB) - turbo accuracy at under half the memory",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-turbo-q5_0.bin",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-turbo-encoder.mlmodelc.zip",
+        "ggml-large-v3-turbo-q5_0.bin",
+        "ggml-large-v3-turbo-encoder.mlmodelc",
+        574,
+        true
+    };
+
+    models_["large-v3-turbo-q8_0"] = {
+        "large-v3-turbo-q8_0",
+        "Large v3 Turbo q8_0 (874 MB) - near-lossless turbo at ~60% of the memory",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-turbo-q8_0.bin",
+        "https://huggingface.co/ggerganov/whisper.cpp/resolve/main/ggml-large-v3-turbo-encoder.mlmodelc.zip",
+        "ggml-large-v3-turbo-q8_0.bin",
+        "ggml-large-v3-turbo-encoder.mlmodelc",
+        874,
+        true
+    };
 }
 
 void ModelManager::ensure_models_directory() {
@@ -197,6 +336,45 @@ std::string ModelManager::get_coreml_model_path(const std::string& model_name) {
     return models_dir_ + "/" + models_[model_name].coreml_filename;
 }
 
+bool ModelManager::ensure_coreml_alias(const std::string& model_name) {
+    auto it = models_.find(model_name);
+    if (it == models_.end()) {
+        return false;
+    }
+    const ModelInfo& info = it->second;
+
+    // Name whisper.cpp will derive from the ggml file at load time
+    std::string derived = info.filename;
+    const std::string bin_ext = ".bin";
+    if (derived.size() > bin_ext.size() &&
+        derived.compare(derived.size() - bin_ext.size(), bin_ext.size(), bin_ext) == 0) {
+        derived.resize(derived.size() - bin_ext.size());
+    }
+    derived += "-encoder.mlmodelc";
+
+    if (derived == info.coreml_filename) {
+        return true; // entry already carries the derived name — no alias needed
+    }
+
+    std::string derived_path = models_dir_ + "/" + derived;
+    std::error_code ec;
+    if (std::filesystem::exists(derived_path, ec)) {
+        return true;
+    }
+    if (!std::filesystem::exists(models_dir_ + "/" + info.coreml_filename, ec)) {
+        return false; // parent encoder not downloaded
+    }
+
+    // Relative symlink keeps the models directory relocatable
+    std::filesystem::create_directory_symlink(info.coreml_filename, derived_path, ec);
+    if (ec) {
+        std::cerr << "⚠️  Could not link CoreML encoder for " << model_name
+                  << ": " << ec.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
 void ModelManager::list_available_models() {
     std::cout << "\n🤖 Available Whisper Models:\n\n";
     
@@ -464,16 +642,23 @@ ModelInfo ModelManager::get_model_info(const std::string& model_name) {
 bool ModelManager::download_file(const std::string& url, const std::string& filepath, bool show_progress) {
     std::cout << "⬇️  Downloading: " << std::filesystem::path(filepath).filename().string() << "\n";
     std::cout << "🔗 From: " << url << "\n";
-    
+
+    // Large files on range-capable servers (HuggingFace supports ranges)
+    // go through the parallel chunked path with resume support
+    RemoteFileInfo remote;
+    if (probe_remote_file(url, remote) && remote.accepts_ranges && remote.size >= PARALLEL_MIN_BYTES) {
+        return download_file_parallel(url, filepath, remote.size, show_progress);
+    }
+
     // Use curl to download with progress
     std::string command = "curl -L --progress-bar \"" + url + "\" -o \"" + filepath + "\"";
-    
+
     if (show_progress) {
         std::cout << "📊 Progress:\n";
     }
-    
+
     int result = std::system(command.c_str());
-    
+
     if (result == 0 && std::filesystem::exists(filepath)) {
         std::cout << "✅ Download completed: " << filepath << "\n";
         return true;
@@ -483,6 +668,153 @@ bool ModelManager::download_file(const std::string& url, const std::string& file
     }
 }
 
+bool ModelManager::probe_remote_file(const std::string& url, RemoteFileInfo& info) {
+    // HEAD request following redirects; parse the final response's headers
+    std::string command = "curl -sIL \"" + url + "\"";
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) return false;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), pipe)) {
+        std::string header(line);
+        std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+        if (header.rfind("content-length:", 0) == 0) {
+            // Keep the last occurrence — earlier ones belong to redirects
+            try {
+                info.size = std::stoull(header.substr(15));
+            } catch (...) {}
+        } else if (header.rfind("accept-ranges:", 0) == 0) {
+            info.accepts_ranges = header.find("bytes") != std::string::npos;
+        } else if (header.rfind("http/", 0) == 0) {
+            // New response (redirect hop) — earlier headers no longer apply
+            info = RemoteFileInfo{};
+        }
+    }
+
+    return pclose(pipe) == 0 && info.size > 0;
+}
+
+bool ModelManager::download_file_parallel(const std::string& url, const std::string& filepath,
+                                          uint64_t total_size, bool show_progress) {
+    const std::string data_path = filepath + ".download";
+    const std::string manifest_path = filepath + ".partial";
+    const size_t n_pieces = static_cast<size_t>((total_size + DOWNLOAD_PIECE_BYTES - 1) / DOWNLOAD_PIECE_BYTES);
+
+    // Resume a matching interrupted download, otherwise start fresh
+    DownloadManifest manifest;
+    bool resuming = false;
+    if (read_download_manifest(manifest_path, manifest) &&
+        manifest.url == url && manifest.size == total_size &&
+        manifest.piece == DOWNLOAD_PIECE_BYTES && manifest.done.size() == n_pieces &&
+        std::filesystem::exists(data_path)) {
+        resuming = true;
+    } else {
+        manifest = DownloadManifest{url, total_size, DOWNLOAD_PIECE_BYTES,
+                                    std::vector<char>(n_pieces, '0')};
+    }
+
+    int fd = ::open(data_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cout << "❌ Cannot create " << data_path << "\n";
+        return false;
+    }
+    // Preallocate as a sparse file so each connection can pwrite its ranges
+    if (ftruncate(fd, static_cast<off_t>(total_size)) != 0) {
+        std::cout << "❌ Cannot preallocate " << data_path << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    uint64_t bytes_already = 0;
+    for (size_t i = 0; i < n_pieces; ++i) {
+        if (manifest.done[i] == '1') {
+            uint64_t offset = i * DOWNLOAD_PIECE_BYTES;
+            bytes_already += std::min(DOWNLOAD_PIECE_BYTES, total_size - offset);
+        }
+    }
+    if (resuming && bytes_already > 0) {
+        std::cout << "↩️  Resuming: " << (bytes_already / (1024 * 1024)) << " MB already downloaded\n";
+    }
+
+    std::atomic<size_t> next_piece{0};
+    std::atomic<uint64_t> bytes_done{bytes_already};
+    std::atomic<bool> failed{false};
+    std::mutex manifest_mutex;
+
+    auto worker = [&]() {
+        while (!failed.load()) {
+            size_t idx = next_piece.fetch_add(1);
+            if (idx >= n_pieces) break;
+            if (manifest.done[idx] == '1') continue;
+
+            uint64_t offset = idx * DOWNLOAD_PIECE_BYTES;
+            uint64_t length = std::min(DOWNLOAD_PIECE_BYTES, total_size - offset);
+
+            bool ok = false;
+            for (int attempt = 0; attempt < 2 && !ok && !failed.load(); ++attempt) {
+                ok = fetch_piece(url, fd, offset, length);
+            }
+            if (!ok) {
+                failed.store(true);
+                break;
+            }
+
+            bytes_done.fetch_add(length);
+            std::lock_guard<std::mutex> lock(manifest_mutex);
+            manifest.done[idx] = '1';
+            write_download_manifest(manifest_path, manifest);
+        }
+    };
+
+    const int n_threads = static_cast<int>(std::min<size_t>(DOWNLOAD_CONNECTIONS, n_pieces));
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+    for (int i = 0; i < n_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    // Aggregate progress across connections on a single updating line
+    while (true) {
+        uint64_t done = bytes_done.load();
+        if (show_progress) {
+            int pct = static_cast<int>(done * 100 / total_size);
+            std::cout << "\r📊 " << (done / (1024 * 1024)) << " / " << (total_size / (1024 * 1024))
+                      << " MB (" << pct << "%) on " << n_threads << " connections   " << std::flush;
+        }
+        if (done >= total_size || failed.load()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    for (auto& t : threads) t.join();
+    if (show_progress) std::cout << "\n";
+
+    if (failed.load()) {
+        ::close(fd);
+        std::cout << "❌ Download interrupted — progress saved, rerun to resume\n";
+        return false; // keep .download + .partial for resume
+    }
+
+    // Every piece arrived with its exact ranged length; final size check
+    // is the last line of defense (the registry publishes no checksums)
+    struct stat st{};
+    bool size_ok = fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) == total_size;
+    ::close(fd);
+    if (!size_ok) {
+        std::cout << "❌ Size mismatch after download: " << data_path << "\n";
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(data_path, filepath, ec);
+    if (ec) {
+        std::cout << "❌ Cannot move " << data_path << " into place: " << ec.message() << "\n";
+        return false;
+    }
+    std::filesystem::remove(manifest_path, ec);
+
+    std::cout << "✅ Download completed: " << filepath << "\n";
+    return true;
+}
+
 bool ModelManager::extract_coreml_model(const std::string& zip_path, const std::string& extract_dir) {
     std::cout << "📦 Extracting CoreML model...\n";
     
@@ -552,6 +884,125 @@ bool ModelManager::download_coreml_model(const std::string& model_name, bool sho
     return extract_coreml_model(zip_path, models_dir_);
 }
 
+namespace {
+    std::string coreml_warmup_cache_path() {
+        const char* home = getenv("HOME");
+        if (!home) return "";
+        return std::string(home) + "/.recognize/coreml-warmup.cache";
+    }
+
+    // Cache key: model file identity (name + size + mtime) plus the macOS
+    // build, since an OS update flushes the system's ANE compilation cache
+    std::string coreml_warmup_key(const std::string& model_path) {
+        struct stat st{};
+        if (stat(model_path.c_str(), &st) != 0) return "";
+
+        std::string os_build = "unknown";
+#ifdef __APPLE__
+        if (FILE* pipe = popen("sw_vers -buildVersion", "r")) {
+            char buf[64];
+            if (fgets(buf, sizeof(buf), pipe)) {
+                os_build.assign(buf);
+                while (!os_build.empty() && (os_build.back() == '\n' || os_build.back() == '\r')) {
+                    os_build.pop_back();
+                }
+            }
+            pclose(pipe);
+        }
+#endif
+
+        std::ostringstream key;
+        key << std::filesystem::path(model_path).filename().string()
+            << "|" << st.st_size << "|" << st.st_mtime << "|" << os_build;
+        return key.str();
+    }
+}
+
+ModelManager::ModelHeader ModelManager::probe_model_header(const std::string& model_path) {
+    ModelHeader header;
+
+    int fd = ::open(model_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return header;
+    }
+
+    // A zero-length or truncated file (the interrupted-download case this
+    // probe exists to catch) would SIGBUS on reads past EOF in the mapping
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) (sizeof(uint32_t) + sizeof(int32_t))) {
+        ::close(fd);
+        return header;
+    }
+
+    // Map only the first page: the ggml magic sits at offset 0 and n_vocab
+    // (first hparam) right behind it — no reason to touch the other 1.5GB
+    void* page = mmap(nullptr, 4096, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (page == MAP_FAILED) {
+        return header;
+    }
+
+    uint32_t magic = 0;
+    int32_t n_vocab = 0;
+    memcpy(&magic, static_cast<const char*>(page), sizeof(magic));
+    memcpy(&n_vocab, static_cast<const char*>(page) + sizeof(magic), sizeof(n_vocab));
+    munmap(page, 4096);
+
+    if (magic != 0x67676d6c) { // "ggml"
+        return header;
+    }
+
+    header.valid = true;
+    header.n_vocab = n_vocab;
+    // English-only vocabularies stop at 51864; the multilingual table adds
+    // the language tokens beyond it
+    header.multilingual = n_vocab >= 51865;
+    return header;
+}
+
+bool ModelManager::coreml_warmup_cached(const std::string& model_path) {
+    std::string key = coreml_warmup_key(model_path);
+    std::string cache_path = coreml_warmup_cache_path();
+    if (key.empty() || cache_path.empty()) return false;
+
+    std::ifstream file(cache_path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line == key) return true;
+    }
+    return false;
+}
+
+void ModelManager::coreml_warmup_record(const std::string& model_path) {
+    std::string key = coreml_warmup_key(model_path);
+    std::string cache_path = coreml_warmup_cache_path();
+    if (key.empty() || cache_path.empty()) return;
+
+    // Keep recent entries (one per model/OS combination); stale keys for
+    // replaced models or old OS builds age out
+    std::vector<std::string> entries;
+    {
+        std::ifstream file(cache_path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line != key) entries.push_back(line);
+        }
+    }
+    entries.push_back(key);
+    const size_t max_entries = 16;
+    if (entries.size() > max_entries) {
+        entries.erase(entries.begin(), entries.end() - max_entries);
+    }
+
+    std::ofstream file(cache_path, std::ios::trunc);
+    if (!file) return;
+    for (const auto& entry : entries) {
+        file << entry << "\n";
+    }
+}
+
 void ModelManager::show_usage_examples(const std::string& model_name) {
     std::cout << "\n🎉 Setup complete! Here's how to use your model:\n\n";
     
@@ -583,9 +1034,78 @@ void ModelManager::show_usage_examples(const std::string& model_name) {
     std::cout << "🚀 Ready to start? Try the VAD mode command above!\n";
 }
 
+namespace {
+    uint64_t physical_ram_bytes() {
+#ifdef __APPLE__
+        uint64_t mem = 0;
+        size_t len = sizeof(mem);
+        if (sysctlbyname("hw.memsize", &mem, &len, nullptr, 0) == 0) {
+            return mem;
+        }
+        return 0;
+#else
+        long pages = sysconf(_SC_PHYS_PAGES);
+        long page  = sysconf(_SC_PAGE_SIZE);
+        return (pages > 0 && page > 0) ? (uint64_t) pages * (uint64_t) page : 0;
+#endif
+    }
+
+    // Pull a model's measured RTF out of ~/.recognize/bench-cache.json
+    // (written by `recognize bench`). Hand-rolled scan matching the writer's
+    // one-result-per-line layout; returns -1 when no measurement exists.
+    double bench_cached_rtf(const std::string& model_name) {
+        const char* home = getenv("HOME");
+        if (!home) return -1.0;
+        std::ifstream file(std::string(home) + "/.recognize/bench-cache.json");
+        if (!file.is_open()) return -1.0;
+
+        const std::string key = "\"model\": \"" + model_name + "\"";
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.find(key) == std::string::npos) continue;
+            size_t pos = line.find("\"rtf\": ");
+            if (pos == std::string::npos) return -1.0;
+            return strtod(line.c_str() + pos + 7, nullptr);
+        }
+        return -1.0;
+    }
+}
+
+std::string ModelManager::select_auto_model() {
+    const uint64_t ram = physical_ram_bytes();
+    const double ram_gib = ram > 0 ? ram / (1024.0 * 1024.0 * 1024.0) : 16.0;
+
+    // RAM tiers: full-precision turbo only where weights + KV + Metal buffers
+    // leave headroom; 16GB machines get the q5_0 variant, smaller machines
+    // step down the family. Candidates are ordered best-first within a tier.
+    std::vector<std::string> candidates;
+    if (ram_gib >= 24.0) {
+        candidates = {"large-v3-turbo", "large-v3-turbo-q8_0", "large-v3-turbo-q5_0"};
+    } else if (ram_gib >= 12.0) {
+        candidates = {"large-v3-turbo-q5_0", "large-v3-turbo-q8_0", "medium.en-q5_0"};
+    } else if (ram_gib >= 6.0) {
+        candidates = {"medium.en-q5_0", "small.en", "small"};
+    } else {
+        candidates = {"base.en", "base", "tiny.en"};
+    }
+
+    // Prefer a candidate that is already on disk; the cached micro-benchmark
+    // vetoes anything measured slower than real time on this machine
+    for (const auto& name : candidates) {
+        if (!model_exists(name)) continue;
+        const double rtf = bench_cached_rtf(name);
+        if (rtf > 0.9) continue;
+        return name;
+    }
+
+    // Nothing suitable downloaded yet — the best candidate for this RAM tier
+    // goes through the normal download flow
+    return candidates.front();
+}
+
 std::string ModelManager::resolve_model(const std::string& model_arg, bool use_coreml) {
     std::string model_name = model_arg;
-    
+
     // If no model specified, prompt user
     if (model_name.empty()) {
         model_name = prompt_model_selection();
@@ -593,7 +1113,14 @@ std::string ModelManager::resolve_model(const std::string& model_arg, bool use_c
             return "";
         }
     }
-    
+
+    // "auto": pick a variant for this machine from RAM size, what is already
+    // downloaded, and the cached micro-benchmark
+    if (model_name == "auto") {
+        model_name = select_auto_model();
+        std::cout << "🤖 Auto-selected model: " << model_name << "\n";
+    }
+
     // Check if it's a direct file path
     if (std::filesystem::exists(model_name)) {
         std::cout << "✅ Using existing model file: " << model_name << "\n";
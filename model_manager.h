@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
 
 struct ModelInfo {
     std::string name;
@@ -22,6 +23,13 @@ public:
     // Check if model exists locally
     bool model_exists(const std::string& model_name);
     bool coreml_model_exists(const std::string& model_name);
+
+    // whisper.cpp derives the encoder path from the ggml filename
+    // (ggml-X.bin → ggml-X-encoder.mlmodelc), so quantized variants that
+    // reuse their parent's encoder need the pairing materialized as a
+    // symlink under the derived name. Returns true once the derived path
+    // exists (trivially so for entries whose encoder name already matches).
+    bool ensure_coreml_alias(const std::string& model_name);
     
     // Get model path
     std::string get_model_path(const std::string& model_name);
@@ -51,8 +59,28 @@ public:
     void set_models_directory(const std::string& models_dir);
     std::string get_models_directory() const;
     
-    // Auto-resolve model (main entry point)
+    // Auto-resolve model (main entry point). "auto" picks a variant for this
+    // machine from RAM size, downloaded models, and the cached benchmark.
     std::string resolve_model(const std::string& model_arg, bool use_coreml);
+    std::string select_auto_model();
+
+    // Probed ggml file header (first page only)
+    struct ModelHeader {
+        bool valid = false;        // ggml magic matched
+        int32_t n_vocab = 0;
+        bool multilingual = false; // n_vocab covers the multilingual token table
+    };
+
+    // Read magic + n_vocab by mapping the first page of the model file —
+    // validates a download and answers the multilingual question without
+    // paying for the full model load.
+    static ModelHeader probe_model_header(const std::string& model_path);
+
+    // CoreML warm-up cache: remembers that ANE compilation already ran for
+    // this exact model file on this OS build, so startup can skip the
+    // dummy inference. Invalidates when the model file or macOS changes.
+    static bool coreml_warmup_cached(const std::string& model_path);
+    static void coreml_warmup_record(const std::string& model_path);
 
     // VAD model management
     std::string resolve_vad_model(const std::string& vad_model_arg);
@@ -68,8 +96,17 @@ private:
     std::map<std::string, ModelInfo> models_;
     std::string models_dir_;
     
+    // Probed metadata for a remote file (HEAD request, following redirects)
+    struct RemoteFileInfo {
+        uint64_t size = 0;
+        bool accepts_ranges = false;
+    };
+
     void init_model_registry();
     bool download_file(const std::string& url, const std::string& filepath, bool show_progress);
+    bool probe_remote_file(const std::string& url, RemoteFileInfo& info);
+    bool download_file_parallel(const std::string& url, const std::string& filepath,
+                                uint64_t total_size, bool show_progress);
     bool extract_coreml_model(const std::string& zip_path, const std::string& extract_dir);
     void show_usage_examples(const std::string& model_name);
     void show_download_progress(const std::string& filename, size_t downloaded, size_t total);
@@ -0,0 +1,109 @@
+#include "perf_stats.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace perf_stats {
+
+namespace {
+    // Histogram buckets are powers of two: bucket 0 is <1ms, bucket k is
+    // [2^(k-1), 2^k) ms, the last bucket collects everything above
+    constexpr int N_BUCKETS = 14; // up to >= 4096ms
+
+    struct StageStats {
+        uint64_t count = 0;
+        double total_ms = 0.0;
+        double min_ms = 0.0;
+        double max_ms = 0.0;
+        uint64_t buckets[N_BUCKETS] = {};
+    };
+
+    std::atomic<bool> g_enabled{false};
+    std::atomic<bool> g_stream{false};
+    std::mutex g_mutex;
+    std::map<std::string, StageStats> g_stages;
+
+    int bucket_for(double ms) {
+        if (ms < 1.0) return 0;
+        int b = 1 + static_cast<int>(std::log2(ms));
+        return b < N_BUCKETS ? b : N_BUCKETS - 1;
+    }
+}
+
+void enable(bool stream_samples) {
+    g_enabled.store(true);
+    g_stream.store(stream_samples);
+}
+
+bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void record(const char* stage, double ms) {
+    if (!enabled()) return;
+
+    if (g_stream.load(std::memory_order_relaxed)) {
+        fprintf(stderr, "{\"stat\":\"%s\",\"ms\":%.2f}\n", stage, ms);
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    StageStats& s = g_stages[stage];
+    if (s.count == 0 || ms < s.min_ms) s.min_ms = ms;
+    if (s.count == 0 || ms > s.max_ms) s.max_ms = ms;
+    s.count++;
+    s.total_ms += ms;
+    s.buckets[bucket_for(ms)]++;
+}
+
+std::string summary_json() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    std::ostringstream json;
+    json << "{\n  \"stats\": {\n";
+    bool first = true;
+    for (const auto& [stage, s] : g_stages) {
+        if (!first) json << ",\n";
+        first = false;
+        json << "    \"" << stage << "\": {"
+             << "\"count\": " << s.count
+             << ", \"total_ms\": " << static_cast<int64_t>(s.total_ms)
+             << ", \"mean_ms\": " << (s.count ? s.total_ms / s.count : 0.0)
+             << ", \"min_ms\": " << s.min_ms
+             << ", \"max_ms\": " << s.max_ms
+             << ", \"hist_pow2_ms\": [";
+        for (int i = 0; i < N_BUCKETS; ++i) {
+            if (i > 0) json << ", ";
+            json << s.buckets[i];
+        }
+        json << "]}";
+    }
+    json << "\n  }\n}\n";
+    return json.str();
+}
+
+void print_summary() {
+    if (!enabled()) return;
+    fprintf(stderr, "%s", summary_json().c_str());
+}
+
+ScopedTimer::ScopedTimer(const char* stage) {
+    if (enabled()) {
+        stage_ = stage;
+        t0_ = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (stage_) {
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0_).count();
+        record(stage_, ms);
+    }
+}
+
+} // namespace perf_stats
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// Lightweight hot-path timing behind --stats: stages of the live session
+// (audio fetch, VAD, inference, output formatting, finalize work) record
+// monotonic durations into per-stage histograms, and a JSON summary is
+// emitted on stderr at exit. --stats-stream additionally prints one JSON
+// line per sample as it is recorded. Near-zero cost when disabled.
+namespace perf_stats {
+
+void enable(bool stream_samples);
+bool enabled();
+
+// Record a sample for a stage. Thread-safe (capture + worker threads).
+void record(const char* stage, double ms);
+
+// Aggregated per-stage summary (count, mean, min/max, log2 histogram)
+std::string summary_json();
+
+// Print the summary to stderr; no-op when stats are disabled
+void print_summary();
+
+// RAII scope timer
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* stage);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* stage_ = nullptr; // nullptr when stats are disabled
+    std::chrono::steady_clock::time_point t0_;
+};
+
+} // namespace perf_stats
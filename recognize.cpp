@@ -1,7 +1,7 @@
 // Real-time speech recognition with CoreML support for macOS
 // Based on whisper.cpp/examples/stream/stream.cpp with CoreML optimizations
 
-#include "common-sdl.h"
+#include "audio_capture.h"
 #include "common.h"
 #include "common-whisper.h"
 #include "whisper.h"
@@ -11,8 +11,14 @@
 #include "ptt_manager.h"
 #include "history_manager.h"
 #include "text_processing.h"
+#include "refine_cache.h"
 #include "meeting_manager.h"
 #include "audio_processor.h"
+#include "audio_ring.h"
+#include "serve_manager.h"
+#include "bench_manager.h"
+#include "batch_processor.h"
+#include "perf_stats.h"
 #include "cli_parser.h"
 #include "whisper_params.h"
 
@@ -28,7 +34,9 @@
 #include <cstdlib>
 #include <csignal>
 #include <atomic>
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -151,10 +159,26 @@ void perform_auto_copy(AutoCopySession& session, const whisper_params& params) {
 }
 
 void perform_export(ExportSession& session, const whisper_params& params) {
-    if (!params.export_enabled || session.segments.empty()) {
+    if (!params.export_enabled) {
         return;
     }
-    
+
+    // Streaming mode: segments are already on disk, just write the footer
+    if (session.stream && session.stream->is_streaming()) {
+        session.metadata.end_time = std::chrono::system_clock::now();
+        session.stream->set_metadata(session.metadata);
+        if (session.stream->stream_end()) {
+            fprintf(stderr, "Export completed successfully.\n");
+        } else {
+            fprintf(stderr, "Export failed.\n");
+        }
+        return;
+    }
+
+    if (session.segments.empty()) {
+        return;
+    }
+
     // Validate export format
     auto supported_formats = ExportManager::get_supported_formats();
     bool format_valid = false;
@@ -226,11 +250,24 @@ static void finalize_session(const whisper_params& params,
                              const std::string& meeting_output_file,
                              const std::string& transcript_text,
                              std::chrono::high_resolution_clock::time_point session_start) {
+    // Queue the history write first so it overlaps with auto-copy, export,
+    // and meeting processing instead of adding to the exit latency
+    if (params.history_enabled && !transcript_text.empty()) {
+        auto now = std::chrono::high_resolution_clock::now();
+        double duration_s = std::chrono::duration<double>(now - session_start).count();
+        std::string mode = params.ptt_mode ? "ptt" :
+                           params.meeting_mode ? "meeting" :
+                           (params.silence_timeout > 0) ? "auto-stop" : "continuous";
+        HistoryManager::queue_save(transcript_text, duration_s, params.model, mode);
+    }
+
     if (params.auto_copy_enabled) {
+        perf_stats::ScopedTimer timer("finalize_auto_copy");
         perform_auto_copy(auto_copy_session, params);
     }
 
     if (params.export_enabled) {
+        perf_stats::ScopedTimer timer("finalize_export");
         export_session.metadata.total_speakers = speaker_tracker.total_speakers;
         perform_export(export_session, params);
     }
@@ -275,19 +312,155 @@ static void finalize_session(const whisper_params& params,
         }
     }
 
-    // Save to history
-    if (params.history_enabled && !transcript_text.empty()) {
-        HistoryManager history;
-        if (history.open()) {
-            auto now = std::chrono::high_resolution_clock::now();
-            double duration_s = std::chrono::duration<double>(now - session_start).count();
-            std::string mode = params.ptt_mode ? "ptt" :
-                               params.meeting_mode ? "meeting" :
-                               (params.silence_timeout > 0) ? "auto-stop" : "continuous";
-            history.save(transcript_text, duration_s, params.model, mode);
+    // Join the background history writer (bounded) before process exit
+    HistoryManager::flush_async();
+}
+
+// ─── Inference pipeline ──────────────────────────────────────────────
+// Dedicated worker thread that runs whisper inference on one audio window
+// while the main loop keeps draining SDL capture into the next one.
+// Single-slot pipeline: the main loop collects the previous window's
+// results before submitting the next, so the whisper contexts are only
+// ever touched by one thread at a time.
+
+struct InferenceJob {
+    std::vector<float> audio;
+    int window_index = 0;
+    std::chrono::high_resolution_clock::time_point t_window;  // capture time of window end
+
+    // Filled in by the worker
+    std::vector<BilingualSegment> results;
+    int rc = 0;
+    int64_t inference_ms = 0;
+};
+
+class InferenceWorker {
+public:
+    InferenceWorker(struct whisper_context* ctx, struct whisper_state* state_translate,
+                    const whisper_params& params)
+        : ctx_(ctx), state_translate_(state_translate), params_(params) {
+        thread_ = std::thread(&InferenceWorker::run, this);
+    }
+
+    ~InferenceWorker() { stop(); }
+
+    // Hand the worker a new window. The main loop collects the previous job
+    // first, so this never actually blocks in the steady state.
+    void submit(InferenceJob&& job, const std::vector<whisper_token>& prompt_tokens) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return !has_pending_; });
+        pending_ = std::move(job);
+        prompt_tokens_ = prompt_tokens;
+        has_pending_ = true;
+        in_flight_ = true;
+        cv_.notify_all();
+    }
+
+    // Wait for the in-flight job and move its results out.
+    // Returns false when nothing was submitted since the last collect.
+    bool collect(InferenceJob& out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!in_flight_) {
+            return false;
+        }
+        cv_.wait(lock, [&] { return has_done_; });
+        out = std::move(done_);
+        has_done_ = false;
+        in_flight_ = false;
+        return true;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+            cv_.notify_all();
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    void run() {
+        #ifdef __APPLE__
+        pthread_set_qos_class_self_np(QOS_CLASS_USER_INITIATED, 0);
+        #endif
+        while (true) {
+            InferenceJob job;
+            std::vector<whisper_token> prompt_tokens;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return has_pending_ || stopping_; });
+                if (!has_pending_) {
+                    return;
+                }
+                job = std::move(pending_);
+                prompt_tokens = std::move(prompt_tokens_);
+                has_pending_ = false;
+                cv_.notify_all();
+            }
+
+            const auto t0 = std::chrono::high_resolution_clock::now();
+
+            {
+                perf_stats::ScopedTimer timer("preprocess_audio");
+                preprocess_audio(job.audio, params_);
+            }
+
+            {
+                perf_stats::ScopedTimer timer("whisper_full");
+                job.rc = process_audio_segment(ctx_, state_translate_, params_, job.audio,
+                                               job.results, prompt_tokens);
+            }
+
+            if (job.rc == 0) {
+                // Hallucination filtering runs here so the capture thread
+                // never waits on text post-processing
+                for (auto& seg : job.results) {
+                    if (!seg.original_text.empty()) {
+                        seg.original_text = filter_hallucinations(seg.original_text);
+                    }
+                    if (!seg.english_text.empty()) {
+                        seg.english_text = filter_hallucinations(seg.english_text);
+                    }
+                }
+                job.results.erase(
+                    std::remove_if(job.results.begin(), job.results.end(),
+                        [](const BilingualSegment& s) {
+                            return s.original_text.empty() && s.english_text.empty();
+                        }),
+                    job.results.end());
+            }
+
+            job.inference_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - t0).count();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_ = std::move(job);
+                has_done_ = true;
+                cv_.notify_all();
+            }
         }
     }
-}
+
+    struct whisper_context* ctx_;
+    struct whisper_state* state_translate_;
+    const whisper_params& params_;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    InferenceJob pending_;
+    InferenceJob done_;
+    std::vector<whisper_token> prompt_tokens_;
+    bool has_pending_ = false;
+    bool has_done_ = false;
+    bool in_flight_ = false;
+    bool stopping_ = false;
+};
 
 int main(int argc, char ** argv) {
     // Handle "history" subcommand before any heavy initialization
@@ -295,7 +468,14 @@ int main(int argc, char ** argv) {
         return handle_history_command(argc - 2, argv + 2);
     }
 
-    ggml_backend_load_all();
+    // "bench" needs the backends but skips audio/session setup entirely.
+    // Everything else defers backend loading (Metal/BLAS init) until a
+    // transcription session is actually confirmed, so --help, model
+    // management, and config queries never pay for it.
+    if (argc >= 2 && std::string(argv[1]) == "bench") {
+        ggml_backend_load_all();
+        return handle_bench_command(argc - 2, argv + 2);
+    }
 
     // Register signal handler for graceful shutdown
     signal(SIGINT, signal_handler);
@@ -311,6 +491,10 @@ int main(int argc, char ** argv) {
         return 1;
     }
 
+    if (params.stats) {
+        perf_stats::enable(params.stats_stream);
+    }
+
     if (params.silence_timeout < 0.0f) {
         fprintf(stderr, "error: --silence-timeout must be non-negative\n");
         return 1;
@@ -343,6 +527,36 @@ int main(int argc, char ** argv) {
         return 1;
     }
 
+    // Validate server mode combinations
+    if (params.serve && (params.ptt_mode || params.meeting_mode)) {
+        fprintf(stderr, "error: --serve is incompatible with --ptt and --meeting\n");
+        return 1;
+    }
+
+    // Validate offline file mode combinations
+    if (!params.input_file.empty()) {
+        if (params.ptt_mode || params.serve || params.client) {
+            fprintf(stderr, "error: --file is incompatible with --ptt, --serve, and --client\n");
+            return 1;
+        }
+        if (params.output_mode == "bilingual") {
+            fprintf(stderr, "warning: --file does not support bilingual output, using 'original' mode\n");
+            params.output_mode = "original";
+        }
+        params.silence_timeout = 0.0f; // no live capture to time out
+    }
+
+    // Thin client mode: run a session against a resident --serve process.
+    // No model load or audio init on this side — the server owns both.
+    if (params.client) {
+        int client_rc = run_transcription_client(params);
+        if (client_rc >= 0) {
+            return client_rc;
+        }
+        fprintf(stderr, "note: no server at %s — running a standalone session\n",
+                server_socket_path().c_str());
+    }
+
     // Initialize model manager
     ModelManager model_manager;
     
@@ -369,6 +583,21 @@ int main(int argc, char ** argv) {
     // Update params with resolved model path
     params.model = resolved_model;
 
+    // Probe the ggml header (first file page) before committing to the load:
+    // fails fast on a corrupt or truncated download, and answers the
+    // multilingual question without waiting for the full mmap
+    ModelManager::ModelHeader model_header = ModelManager::probe_model_header(resolved_model);
+    if (!model_header.valid) {
+        std::cerr << "\n❌ '" << resolved_model << "' is not a valid ggml model (corrupt or incomplete download?)\n";
+        return 1;
+    }
+    if (!model_header.multilingual && (params.language != "en" || params.translate)) {
+        // English-only model: settle the language handling from the header
+        // instead of after the full load
+        params.language = "en";
+        params.translate = false;
+    }
+
     // Extract short model name for display (e.g. "ggml-large-v3-turbo.bin" → "large-v3-turbo")
     std::string display_model = std::filesystem::path(resolved_model).stem().string();
     if (display_model.rfind("ggml-", 0) == 0) {
@@ -388,7 +617,11 @@ int main(int argc, char ** argv) {
         for (const auto& name : model_manager.get_model_names()) {
             if (model_manager.get_model_path(name) == resolved_model) {
                 std::string coreml_path = model_manager.get_coreml_model_path(name);
-                if (model_manager.coreml_model_exists(name)) {
+                // ensure_coreml_alias materializes the parent-encoder pairing
+                // for quantized variants — whisper.cpp only looks for the
+                // name derived from the ggml filename
+                if (model_manager.coreml_model_exists(name) &&
+                    model_manager.ensure_coreml_alias(name)) {
                     params.coreml_model = coreml_path;
                 } else {
                     params.use_coreml = false;  // Disable CoreML to prevent crashes
@@ -419,11 +652,6 @@ int main(int argc, char ** argv) {
         }
     }
 
-    // Resolve VAD model path (supports "auto" for auto-download)
-    if (!params.vad_model_path.empty()) {
-        params.vad_model_path = model_manager.resolve_vad_model(params.vad_model_path);
-    }
-
     // Meeting mode: apply optimized defaults (can still be overridden by explicit CLI args)
     // These are set after CLI parsing so they only apply if the user didn't explicitly set them
     if (params.meeting_mode) {
@@ -504,23 +732,45 @@ int main(int argc, char ** argv) {
 
     auto t_init_start = std::chrono::high_resolution_clock::now();
 
-    // Parallel init: load model and init audio simultaneously.
-    // Model load is I/O-bound (1.5GB mmap), audio init is device-bound —
-    // running them in parallel saves 0.3-0.5s on cold start.
+    // Parallel init: the model load (I/O-bound 1.5GB mmap), audio init
+    // (device-bound), and VAD model resolution (possibly a download) all
+    // run concurrently — serialized, they cost their sum on cold start.
     int audio_buffer_ms = params.length_ms;
     if (params.ptt_mode) {
         audio_buffer_ms = std::max(audio_buffer_ms, 600000 + params.ptt_pre_roll_ms);
     }
+    #ifdef WHISPER_COREML
+    // A cold CoreML warm-up can run for tens of seconds with capture already
+    // live — size the ring to hold that speech so catch-up can replay it
+    if (params.use_coreml && !params.coreml_no_ane &&
+        !ModelManager::coreml_warmup_cached(params.model)) {
+        audio_buffer_ms = std::max(audio_buffer_ms, 120000);
+    }
+    #endif
 
     std::atomic<bool> audio_ok{false};
-    audio_async audio(audio_buffer_ms);
+    audio_capture audio(audio_buffer_ms);
     auto audio_future = std::async(std::launch::async, [&]() {
         int saved = suppress_stderr();
         audio_ok.store(audio.init(params.capture_id, WHISPER_SAMPLE_RATE));
         restore_stderr(saved);
     });
 
-    struct whisper_context * ctx = whisper_init_from_file_with_params(params.model.c_str(), cparams);
+    // Backends load just-in-time: only a confirmed session reaches this
+    // point, so management commands never paid for Metal/BLAS init
+    ggml_backend_load_all();
+
+    auto ctx_future = std::async(std::launch::async, [&]() {
+        return whisper_init_from_file_with_params(params.model.c_str(), cparams);
+    });
+
+    // Resolve the VAD model while the whisper context loads — "auto" may
+    // download it, which now overlaps the model mmap instead of preceding it
+    if (!params.vad_model_path.empty()) {
+        params.vad_model_path = model_manager.resolve_vad_model(params.vad_model_path);
+    }
+
+    struct whisper_context * ctx = ctx_future.get();
     if (ctx == nullptr) {
         whisper_log_set(nullptr, nullptr);
         ggml_log_set(nullptr, nullptr);
@@ -528,15 +778,18 @@ int main(int argc, char ** argv) {
         return 2;
     }
 
-    // Wait for audio init to complete
+    // Wait for audio init to complete — offline file mode tolerates a
+    // missing capture device since it never reads the microphone
     audio_future.wait();
-    if (!audio_ok.load()) {
+    if (!audio_ok.load() && params.input_file.empty()) {
         fprintf(stderr, "%s: audio.init() failed!\n", __func__);
         whisper_free(ctx);
         return 1;
     }
 
-    audio.resume();
+    if (params.input_file.empty()) {
+        audio.resume();
+    }
 
     if (stderr_is_tty) {
         auto t_model_loaded = std::chrono::high_resolution_clock::now();
@@ -555,29 +808,45 @@ int main(int argc, char ** argv) {
     // CoreML warm-up: first inference triggers ANE compilation
     // For large models this can take 30s+ on first run (ANE caches for subsequent runs)
     // Skip when coreml_no_ane — CPU+GPU mode has no ANE compilation overhead
+    // A warm-up cache entry (~/.recognize/coreml-warmup.cache) means ANE
+    // compilation already ran for this model on this OS build, so the
+    // ~1s dummy inference is skipped entirely
+    // Audio captured while the warm-up runs (capture is already live) —
+    // drained through the catch-up pass below once the context is ready
+    int64_t warmup_backlog_ms = 0;
+
     #ifdef WHISPER_COREML
     if (params.use_coreml && !params.coreml_no_ane) {
-        if (stderr_is_tty) {
-            fprintf(stderr, "[Warming up CoreML (first run may take a while)...]\n");
-            fflush(stderr);
-        }
-        auto t_warmup_start = std::chrono::high_resolution_clock::now();
-
-        std::vector<float> warmup(WHISPER_SAMPLE_RATE * 1, 0.0f); // 1 second of silence
-        whisper_full_params wp = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
-        wp.print_realtime   = false;
-        wp.print_progress   = false;
-        wp.print_timestamps = false;
-        wp.print_special    = false;
-        wp.n_threads        = params.n_threads;
-        wp.single_segment   = true;
-        wp.max_tokens       = 1;
-        whisper_full(ctx, wp, warmup.data(), warmup.size());
+        if (ModelManager::coreml_warmup_cached(params.model)) {
+            if (stderr_is_tty) {
+                fprintf(stderr, "[CoreML warm from previous run]\n");
+            }
+        } else {
+            if (stderr_is_tty) {
+                fprintf(stderr, "[Warming up CoreML (first run may take a while)...]\n");
+                fflush(stderr);
+            }
+            auto t_warmup_start = std::chrono::high_resolution_clock::now();
+
+            std::vector<float> warmup(WHISPER_SAMPLE_RATE * 1, 0.0f); // 1 second of silence
+            whisper_full_params wp = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+            wp.print_realtime   = false;
+            wp.print_progress   = false;
+            wp.print_timestamps = false;
+            wp.print_special    = false;
+            wp.n_threads        = params.n_threads;
+            wp.single_segment   = true;
+            wp.max_tokens       = 1;
+            whisper_full(ctx, wp, warmup.data(), warmup.size());
+
+            ModelManager::coreml_warmup_record(params.model);
 
-        if (stderr_is_tty) {
             auto t_warmup_end = std::chrono::high_resolution_clock::now();
             auto warmup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t_warmup_end - t_warmup_start).count();
-            fprintf(stderr, "[CoreML ready in %.1fs]\n", warmup_ms / 1000.0);
+            warmup_backlog_ms = warmup_ms + 500; // margin so the first words aren't clipped
+            if (stderr_is_tty) {
+                fprintf(stderr, "[CoreML ready in %.1fs]\n", warmup_ms / 1000.0);
+            }
         }
     }
     #endif
@@ -609,22 +878,66 @@ int main(int argc, char ** argv) {
         return 1;
     }
     
-    // For bilingual mode, we need a second context for translation
-    struct whisper_context * ctx_translate = nullptr;
+    // For bilingual mode, the translation pass decodes on its own
+    // whisper_state against the same context — one set of model weights
+    // (and Metal/CoreML buffers) shared between both streams
+    struct whisper_state * state_translate = nullptr;
     if (params.output_mode == "bilingual") {
-        ctx_translate = whisper_init_from_file_with_params(params.model.c_str(), cparams);
-        if (ctx_translate == nullptr) {
-            fprintf(stderr, "error: failed to initialize translation context for bilingual mode\n");
+        state_translate = whisper_init_state(ctx);
+        if (state_translate == nullptr) {
+            fprintf(stderr, "error: failed to initialize translation state for bilingual mode\n");
             whisper_free(ctx);
             return 2;
         }
     }
 
+    // ─── Draft model ─────────────────────────────────────────────────────
+    // whisper.cpp's public API has no hook for feeding draft tokens into the
+    // main decoder, so full speculative decoding is out of reach from this
+    // side of whisper_full(). The draft context still buys perceived latency:
+    // a tiny model decodes each window in a few hundred ms and its text shows
+    // on the dim draft line while the main decode finishes.
+    struct whisper_context * ctx_draft = nullptr;
+    if (!params.draft_model.empty()) {
+        std::string draft_path = model_manager.resolve_model(params.draft_model, false);
+        if (draft_path.empty()) {
+            fprintf(stderr, "%s: draft model '%s' not available, continuing without it\n",
+                    __func__, params.draft_model.c_str());
+        } else if (draft_path == params.model) {
+            fprintf(stderr, "%s: draft model resolves to the main model, ignoring --draft-model\n", __func__);
+        } else {
+            ctx_draft = whisper_init_from_file_with_params(draft_path.c_str(), cparams);
+            if (ctx_draft == nullptr) {
+                fprintf(stderr, "%s: failed to load draft model '%s', continuing without it\n",
+                        __func__, params.draft_model.c_str());
+            } else {
+                set_draft_context(ctx_draft);
+            }
+        }
+    }
+
+    // ─── Server mode ─────────────────────────────────────────────────────
+    // Keep the loaded (and warmed-up) context resident and serve capture
+    // sessions to --client invocations over a Unix socket
+    if (params.serve) {
+        g_is_recording.store(false);
+        int serve_rc = run_transcription_server(ctx, state_translate, params, audio);
+        audio.pause();
+        whisper_free(ctx);
+        if (state_translate) whisper_free_state(state_translate);
+        if (ctx_draft) whisper_free(ctx_draft);
+        return serve_rc;
+    }
+
     std::vector<float> pcmf32    (n_samples_30s, 0.0f);
-    std::vector<float> pcmf32_old;
-    pcmf32_old.reserve(n_samples_30s);
     std::vector<float> pcmf32_new(n_samples_30s, 0.0f);
 
+    // Sliding-window staging ring: capture pushes each new chunk once and
+    // the inference window is read back as a contiguous span (audio_ring.h)
+    AudioRing audio_ring(n_samples_keep + n_samples_len + 2*n_samples_step);
+    size_t n_samples_history = 0; // history eligible as context for the next window
+    size_t n_samples_window  = 0; // size of the currently assembled window
+
     std::vector<whisper_token> prompt_tokens;
 
     // Auto-correct language settings for non-multilingual models
@@ -635,13 +948,15 @@ int main(int argc, char ** argv) {
         }
     }
 
-    int n_iter = 0;
     bool is_running = true;
 
     const bool stdout_is_tty = isatty(STDOUT_FILENO);
     // When stdout is not a TTY (redirected to file/pipe), accumulate text
-    // and dump it on exit instead of streaming with ANSI codes
-    std::string pipe_finalized_text;
+    // and dump it on exit instead of streaming with ANSI codes. Finalized
+    // text goes to the on-disk journal so an all-day session doesn't hold
+    // its whole transcript in RAM
+    TranscriptJournal pipe_finalized_text;
+    pipe_finalized_text.open("pipe-" + std::to_string(getpid()));
     std::ostringstream pipe_current_text;
 
     std::ofstream fout;
@@ -650,7 +965,8 @@ int main(int argc, char ** argv) {
         if (!fout.is_open()) {
             fprintf(stderr, "%s: failed to open output file '%s'!\n", __func__, params.fname_out.c_str());
             whisper_free(ctx);
-            if (ctx_translate) whisper_free(ctx_translate);
+            if (state_translate) whisper_free_state(state_translate);
+            if (ctx_draft) whisper_free(ctx_draft);
             return 1;
         }
     }
@@ -689,6 +1005,30 @@ int main(int argc, char ** argv) {
 #endif
     }
 
+    // Streaming export: open the file now and append each segment as it
+    // finalizes — constant memory and crash-safe for long sessions
+    ExportManager stream_export;
+    if (params.export_enabled && params.export_stream) {
+        ExportFormat stream_format = ExportManager::extension_to_format("." + params.export_format);
+        if (!ExportManager::format_supports_streaming(stream_format)) {
+            fprintf(stderr, "warning: --export-stream does not support '%s' (needs a closing document structure), using end-of-session export\n",
+                    params.export_format.c_str());
+        } else {
+            stream_export.set_format(stream_format);
+            if (!params.export_file.empty()) {
+                stream_export.set_output_file(params.export_file);
+            }
+            stream_export.set_auto_filename(params.export_auto_filename);
+            stream_export.set_include_metadata(params.export_include_metadata);
+            stream_export.set_include_timestamps(params.export_include_timestamps);
+            stream_export.set_include_confidence(params.export_include_confidence);
+            stream_export.set_metadata(export_session.metadata);
+            if (stream_export.stream_begin()) {
+                export_session.stream = &stream_export;
+            }
+        }
+    }
+
     // Initialize speaker tracker and meeting session
     SpeakerTracker speaker_tracker;
     MeetingSession meeting_session;
@@ -697,6 +1037,143 @@ int main(int argc, char ** argv) {
         meeting_output_file = generate_meeting_filename(params.meeting_name);
     }
 
+    // ─── Offline file transcription ──────────────────────────────────────
+    // Decode + VAD-chunk the file and run a pool of whisper_states in
+    // parallel (batch_processor.h), then hand the ordered segments to the
+    // same display/export/meeting pipeline the live session uses
+    if (!params.input_file.empty()) {
+        if (audio_ok.load()) {
+            audio.pause();
+        }
+        params.no_timestamps = false; // batch output is timestamped like VAD mode
+
+        std::vector<BilingualSegment> batch_segments;
+        double batch_audio_s = 0.0;
+        const auto t_batch_start = std::chrono::high_resolution_clock::now();
+        bool batch_ok = run_batch_transcription(ctx, params, batch_segments, batch_audio_s);
+
+        if (batch_ok) {
+            std::ostringstream* pbuf = stdout_is_tty ? nullptr : &pipe_current_text;
+            {
+                perf_stats::ScopedTimer timer("print_results");
+                print_bilingual_results(batch_segments, params, auto_copy_session, export_session,
+                                        speaker_tracker, &meeting_session, stdout_is_tty, pbuf, true);
+            }
+
+            if (stderr_is_tty && batch_audio_s > 0.0) {
+                double wall_s = std::chrono::duration<double>(
+                    std::chrono::high_resolution_clock::now() - t_batch_start).count();
+                fprintf(stderr, "[Transcribed %.1fs of audio in %.1fs — %.1fx real time]\n",
+                        batch_audio_s, wall_s, wall_s > 0.0 ? batch_audio_s / wall_s : 0.0);
+            }
+
+            if (params.refine) {
+                std::string raw_pipe = pipe_current_text.str();
+                if (!raw_pipe.empty()) {
+                    pipe_current_text.str(refine_transcription_cached(raw_pipe));
+                }
+                if (params.auto_copy_enabled) {
+                    std::string raw_copy = auto_copy_session.transcription_buffer.str();
+                    if (!raw_copy.empty()) {
+                        auto_copy_session.transcription_buffer.str(refine_transcription_cached(raw_copy));
+                    }
+                }
+            }
+
+            // Dump accumulated text to stdout when not a TTY (pipe/redirect mode)
+            if (!stdout_is_tty) {
+                std::string final_text = pipe_current_text.str();
+                if (!final_text.empty()) {
+                    printf("%s\n", final_text.c_str());
+                    fflush(stdout);
+                }
+            }
+
+            std::string history_text;
+            if (params.meeting_mode) {
+                history_text = meeting_session.get_transcription();
+            } else if (!stdout_is_tty) {
+                history_text = pipe_current_text.str();
+            } else {
+                history_text = auto_copy_session.transcription_buffer.str();
+            }
+
+            finalize_session(params, auto_copy_session, export_session, speaker_tracker,
+                             meeting_session, meeting_output_file, history_text, t_batch_start);
+        }
+
+        g_is_recording.store(false);
+        whisper_free(ctx);
+        if (state_translate) whisper_free_state(state_translate);
+        if (ctx_draft) whisper_free(ctx_draft);
+        perf_stats::print_summary();
+        return batch_ok ? 0 : 1;
+    }
+
+    // ─── Warm-up catch-up ────────────────────────────────────────────────
+    // Capture was live during the CoreML warm-up, so anything the user said
+    // is sitting in the ring. Replay it through the normal inference path in
+    // ≤30s chunks — decoding runs faster than real time, so this converges —
+    // before live streaming takes over. Same buffer-backfill pattern as the
+    // PTT pre-roll. PTT itself skips this: its session starts on key press.
+    if (warmup_backlog_ms > 1000 && !params.ptt_mode) {
+        std::vector<float> backlog;
+        audio.get((int) warmup_backlog_ms, backlog);
+        audio.clear();
+
+        // Only bother when the backlog actually contains speech
+        std::vector<float> backlog_vad(backlog);
+        if (!backlog.empty() &&
+            ::vad_simple(backlog_vad, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false)) {
+            if (stderr_is_tty) {
+                fprintf(stderr, "[Catching up on %.1fs captured during warm-up...]\n",
+                        backlog.size() / (float) WHISPER_SAMPLE_RATE);
+            }
+
+            const size_t n_chunk_max = (size_t) n_samples_30s;
+            for (size_t pos = 0; pos < backlog.size(); pos += n_chunk_max) {
+                const size_t n_chunk = std::min(n_chunk_max, backlog.size() - pos);
+                std::vector<float> chunk(backlog.begin() + pos, backlog.begin() + pos + n_chunk);
+                preprocess_audio(chunk, params);
+
+                std::vector<BilingualSegment> catchup_results;
+                if (process_audio_segment(ctx, state_translate, params, chunk, catchup_results) != 0) {
+                    continue;
+                }
+                for (auto& seg : catchup_results) {
+                    if (!seg.original_text.empty()) {
+                        seg.original_text = filter_hallucinations(seg.original_text);
+                    }
+                    if (!seg.english_text.empty()) {
+                        seg.english_text = filter_hallucinations(seg.english_text);
+                    }
+                }
+                catchup_results.erase(
+                    std::remove_if(catchup_results.begin(), catchup_results.end(),
+                        [](const BilingualSegment& s) {
+                            return s.original_text.empty() && s.english_text.empty();
+                        }),
+                    catchup_results.end());
+                if (catchup_results.empty()) {
+                    continue;
+                }
+
+                std::ostringstream* pbuf = stdout_is_tty ? nullptr : &pipe_current_text;
+                print_bilingual_results(catchup_results, params, auto_copy_session, export_session,
+                                        speaker_tracker, &meeting_session, stdout_is_tty, pbuf, true);
+                if (stdout_is_tty) {
+                    printf("\n");
+                }
+            }
+
+            if (!stdout_is_tty) {
+                pipe_finalized_text += pipe_current_text.str();
+                pipe_current_text.str("");
+                pipe_current_text.clear();
+            }
+        }
+    }
+
     // ─── Push-to-Talk mode ───────────────────────────────────────────────
     if (params.ptt_mode) {
         // For English input, force transcription mode instead of translation.
@@ -713,7 +1190,8 @@ int main(int argc, char ** argv) {
         if (!ptt.start(ptt_key_code)) {
             fprintf(stderr, "Failed to start PTT. Check Input Monitoring permissions.\n");
             whisper_free(ctx);
-            if (ctx_translate) whisper_free(ctx_translate);
+            if (state_translate) whisper_free_state(state_translate);
+            if (ctx_draft) whisper_free(ctx_draft);
             return 7;
         }
 
@@ -817,7 +1295,7 @@ int main(int argc, char ** argv) {
                     std::vector<float> preview_audio;
                     audio.get(preview_ms, preview_audio);
 
-                    if (params.normalize_audio) normalize_audio(preview_audio);
+                    preprocess_audio(preview_audio, params);
 
                     // Capture parameters by value for the async task.
                     // ctx is safe: only one whisper_full() runs at a time because
@@ -916,9 +1394,7 @@ int main(int argc, char ** argv) {
                 }
             }
 
-            if (params.normalize_audio) {
-                normalize_audio(pcmf32_ptt);
-            }
+            preprocess_audio(pcmf32_ptt, params);
 
             float actual_duration_s = pcmf32_ptt.size() / static_cast<float>(WHISPER_SAMPLE_RATE);
             if (stderr_tty) fprintf(stderr, "\r[Transcribing %.1fs...]        ", actual_duration_s);
@@ -977,7 +1453,7 @@ int main(int argc, char ** argv) {
                 ptt_params.no_context = (offset == 0);
 
                 std::vector<BilingualSegment> chunk_results;
-                if (process_audio_segment(ctx, ctx_translate, ptt_params, chunk,
+                if (process_audio_segment(ctx, state_translate, ptt_params, chunk,
                                           chunk_results, ptt_prompt_tokens) != 0) {
                     fprintf(stderr, "\nfailed to process audio chunk\n");
                     inference_failed = true;
@@ -1041,7 +1517,7 @@ int main(int argc, char ** argv) {
                         std::vector<float> chunk(pcmf32_ptt.begin() + offset,
                                                   pcmf32_ptt.begin() + offset + chunk_size);
                         std::vector<BilingualSegment> retry_results;
-                        if (process_audio_segment(ctx, ctx_translate, retry_params, chunk,
+                        if (process_audio_segment(ctx, state_translate, retry_params, chunk,
                                                   retry_results, prompt_tokens) == 0) {
                             for (auto& seg : retry_results) {
                                 if (!seg.original_text.empty())
@@ -1074,7 +1550,7 @@ int main(int argc, char ** argv) {
                     else if (!seg.english_text.empty()) raw_text += seg.english_text;
                 }
                 if (!raw_text.empty()) {
-                    std::string refined = refine_transcription(raw_text);
+                    std::string refined = refine_transcription_cached(raw_text);
                     // Replace all segments with a single refined segment
                     BilingualSegment refined_seg = bilingual_results[0];
                     if (!refined_seg.original_text.empty()) {
@@ -1131,12 +1607,9 @@ int main(int argc, char ** argv) {
                     ? auto_copy_session.transcription_buffer.str()
                     : ptt_pipe_text;
                 if (params.history_enabled && !iter_text.empty()) {
-                    HistoryManager history;
-                    if (history.open()) {
-                        auto now = std::chrono::high_resolution_clock::now();
-                        double duration_s = std::chrono::duration<double>(now - t_press).count();
-                        history.save(iter_text, duration_s, params.model, "ptt");
-                    }
+                    auto now = std::chrono::high_resolution_clock::now();
+                    double duration_s = std::chrono::duration<double>(now - t_press).count();
+                    HistoryManager::queue_save(iter_text, duration_s, params.model, "ptt");
                 }
 
                 // Clear state for next iteration
@@ -1195,11 +1668,18 @@ int main(int argc, char ** argv) {
 
             finalize_session(params, auto_copy_session, export_session, speaker_tracker,
                              meeting_session, meeting_output_file, history_text, auto_copy_session.start_time);
+        } else {
+            // Loop mode queued saves per-iteration and skips finalize_session,
+            // so join the background history writer here — otherwise its
+            // thread is still joinable at static destruction and aborts
+            HistoryManager::flush_async();
         }
 
         g_is_recording.store(false);
         whisper_free(ctx);
-        if (ctx_translate) whisper_free(ctx_translate);
+        if (state_translate) whisper_free_state(state_translate);
+        if (ctx_draft) whisper_free(ctx_draft);
+        perf_stats::print_summary();
         return 0;
     }
 
@@ -1219,6 +1699,206 @@ int main(int argc, char ** argv) {
     bool has_spoken = false;
     const bool silence_timeout_enabled = params.silence_timeout > 0.0f && !params.meeting_mode;
 
+    // ─── Dual-stream capture (--capture-system) ──────────────────────────
+    // Meeting mode can open a second SDL stream on a loopback/aggregate
+    // device so remote call participants are heard directly instead of via
+    // speaker bleed. The system stream decodes on its own whisper_state
+    // (sharing ctx's weights, same mechanism as the batch workers) in
+    // parallel with the mic window, and its segments merge in tagged as
+    // channel 1 before entering the meeting transcript.
+    audio_capture audio_system(audio_buffer_ms);
+    struct whisper_state * state_system = nullptr;
+    bool dual_capture = false;
+    if (params.capture_system_id >= 0) {
+        if (!params.meeting_mode) {
+            fprintf(stderr, "%s: --capture-system only applies in meeting mode — ignoring\n", __func__);
+        } else if (!audio_system.init(params.capture_system_id, WHISPER_SAMPLE_RATE)) {
+            fprintf(stderr, "%s: failed to open system-audio device %d — continuing with mic only\n",
+                    __func__, params.capture_system_id);
+        } else {
+            state_system = whisper_init_state(ctx);
+            if (state_system == nullptr) {
+                fprintf(stderr, "%s: failed to create system-stream state — continuing with mic only\n", __func__);
+            } else {
+                audio_system.resume();
+                dual_capture = true;
+                fprintf(stderr, "%s: system-audio capture active on device %d\n", __func__, params.capture_system_id);
+            }
+        }
+    }
+    std::future<int> system_future;
+    std::vector<BilingualSegment> system_results;
+    std::vector<float> pcmf32_system;
+
+    // Inference worker — capture keeps filling the next window while
+    // whisper_full() runs on the previous one
+    InferenceWorker worker(ctx, state_translate, params);
+    int window_index = 0;
+    int n_windows_behind = 0;
+    int n_chunks_gated = 0;
+
+    // --adaptive-step state: the effective step floats between half and double
+    // the configured step based on a rolling decode RTF. n_samples_step stays
+    // the baseline for ring sizing, the drop guard, and the backpressure check.
+    int n_samples_step_eff = n_samples_step;
+    const int n_samples_step_min = std::max(1, n_samples_step / 2);
+    const int n_samples_step_max = std::min(2 * n_samples_step, n_samples_len);
+    double decode_rtf_ema = 0.0;
+
+    // Collect the system-stream decode launched alongside the mic submit and
+    // fold its segments into the mic window. Both decodes cover the same
+    // wall-clock span, so window-relative timestamps interleave directly.
+    auto merge_system_results = [&](InferenceJob& job) {
+        if (!system_future.valid()) {
+            return;
+        }
+        const int rc_system = system_future.get();
+        if (rc_system == 0 && !system_results.empty()) {
+            for (auto& seg : system_results) {
+                seg.channel = 1;
+            }
+            job.results.insert(job.results.end(),
+                               std::make_move_iterator(system_results.begin()),
+                               std::make_move_iterator(system_results.end()));
+            std::stable_sort(job.results.begin(), job.results.end(),
+                             [](const BilingualSegment& a, const BilingualSegment& b) {
+                                 return a.t0 < b.t0;
+                             });
+        }
+        system_results.clear();
+    };
+
+    // Emit one completed window: display, pipe buffering, and session
+    // accumulation. Runs on the main thread while the worker is idle, so
+    // reading the whisper context here is safe.
+    auto emit_window = [&](InferenceJob& job) {
+        // In sliding window mode, only accumulate to meeting/auto-copy/export/fout
+        // at finalization boundaries (when the window has the most complete text).
+        // VAD mode: every iteration is independent, so always accumulate.
+        const bool is_boundary = use_vad || (((job.window_index + 1) % n_new_line) == 0);
+
+        // For pipe mode: clear current buffer before re-rendering
+        if (!stdout_is_tty && !use_vad) {
+            pipe_current_text.str("");
+            pipe_current_text.clear();
+        }
+
+        if (!use_vad) {
+            if (stdout_is_tty) {
+                printf("\33[2K\r");
+                printf("%s", std::string(100, ' ').c_str());
+                printf("\33[2K\r");
+            }
+        } else {
+            const int64_t t1 = (job.t_window - t_start).count()/1000000;
+            const int64_t t0 = std::max(0.0, t1 - job.audio.size()*1000.0/WHISPER_SAMPLE_RATE);
+            if (stdout_is_tty) {
+                printf("\n### Transcription %d START | t0 = %d ms | t1 = %d ms\n", job.window_index, (int) t0, (int) t1);
+                printf("\n");
+            }
+        }
+
+        // Use colored token output if enabled, otherwise use segment-based output
+        if (params.print_colors) {
+            // Print tokens directly from whisper context with colors
+            const int n_segments = whisper_full_n_segments(ctx);
+            for (int i = 0; i < n_segments; ++i) {
+                if (stdout_is_tty) {
+                    if (!params.no_timestamps) {
+                        const int64_t t0 = whisper_full_get_segment_t0(ctx, i);
+                        const int64_t t1 = whisper_full_get_segment_t1(ctx, i);
+                        printf("[%s --> %s]  ", to_timestamp(t0).c_str(), to_timestamp(t1).c_str());
+                    }
+                    print_colored_tokens(ctx, i, params);
+                    printf("\n");
+                }
+
+                // Accumulate text for pipe even in color mode (always for display)
+                const char* seg_text = whisper_full_get_segment_text(ctx, i);
+                bool speaker_turn = whisper_full_get_segment_speaker_turn_next(ctx, i);
+
+                // Use shared speaker tracker
+                int seg_speaker_id = speaker_tracker.get_current();
+                if (speaker_turn) {
+                    seg_speaker_id = speaker_tracker.on_turn();
+                }
+
+                if (!stdout_is_tty) {
+                    pipe_current_text << seg_text;
+                }
+                // Only accumulate to persistent buffers at finalization boundaries
+                if (is_boundary) {
+                    if (params.meeting_mode) {
+                        meeting_session.add_transcription(std::string(seg_text), speaker_turn);
+                        meeting_session.add_transcription(" ");
+                    }
+                    if ((params.auto_copy_enabled && should_auto_copy(auto_copy_session, params)) || params.history_enabled) {
+                        auto_copy_session.transcription_buffer << seg_text;
+                    }
+                    if (params.export_enabled) {
+                        int64_t t0 = whisper_full_get_segment_t0(ctx, i);
+                        int64_t t1 = whisper_full_get_segment_t1(ctx, i);
+                        export_session.add_segment(t0 / 10, t1 / 10, std::string(seg_text), 1.0f, speaker_turn, speaker_turn ? seg_speaker_id : -1);
+                    }
+                }
+            }
+        } else {
+            // Use segment-based bilingual output
+            std::ostringstream* pbuf = stdout_is_tty ? nullptr : &pipe_current_text;
+            perf_stats::ScopedTimer timer("print_results");
+            print_bilingual_results(job.results, params, auto_copy_session, export_session, speaker_tracker, &meeting_session,
+                                    stdout_is_tty, pbuf, is_boundary);
+        }
+
+        if (is_boundary && params.fname_out.length() > 0) {
+            const int n_seg = whisper_full_n_segments(ctx);
+            for (int i = 0; i < n_seg; ++i) {
+                const char* seg_text = whisper_full_get_segment_text(ctx, i);
+                if (seg_text) {
+                    fout << seg_text;
+                }
+            }
+            fout << std::endl;
+            fout.flush();
+        }
+
+        if (use_vad) {
+            if (stdout_is_tty) {
+                printf("\n### Transcription %d END\n", job.window_index);
+            }
+            // In VAD mode, each iteration is independent — finalize immediately
+            if (!stdout_is_tty) {
+                pipe_finalized_text += pipe_current_text.str();
+                pipe_current_text.str("");
+                pipe_current_text.clear();
+            }
+        }
+
+        if (!use_vad && is_boundary) {
+            if (stdout_is_tty) {
+                printf("\n");
+            }
+            // Finalize current group's text for pipe output
+            if (!stdout_is_tty) {
+                pipe_finalized_text += pipe_current_text.str();
+                pipe_current_text.str("");
+                pipe_current_text.clear();
+            }
+
+            if (!params.no_context) {
+                prompt_tokens.clear();
+                const int n_segments = whisper_full_n_segments(ctx);
+                for (int i = 0; i < n_segments; ++i) {
+                    const int token_count = whisper_full_n_tokens(ctx, i);
+                    for (int j = 0; j < token_count; ++j) {
+                        prompt_tokens.push_back(whisper_full_get_token_id(ctx, i, j));
+                    }
+                }
+            }
+        }
+        fflush(stdout);
+    };
+
     // Main audio processing loop
     while (is_running && !check_interrupt_with_confirmation()) {
         if (params.save_audio) {
@@ -1231,6 +1911,7 @@ int main(int argc, char ** argv) {
         }
 
         // Process new audio
+        bool gate_skip = false;
         if (!use_vad) {
             while (true) {
                 is_running = sdl_poll_events();
@@ -1238,7 +1919,14 @@ int main(int argc, char ** argv) {
                     break;
                 }
                 
-                audio.get(params.step_ms, pcmf32_new);
+                {
+                    perf_stats::ScopedTimer timer("audio_get");
+                    // Fetch the effective step's duration: get() caps the
+                    // result at the requested span, so asking for the base
+                    // step would make an adaptively grown step unreachable
+                    const int step_eff_ms = (int) ((int64_t) n_samples_step_eff * 1000 / WHISPER_SAMPLE_RATE);
+                    audio.get(step_eff_ms, pcmf32_new);
+                }
 
                 if ((int) pcmf32_new.size() > 2*n_samples_step) {
                     fprintf(stderr, "\n\n%s: WARNING: cannot process audio fast enough, dropping audio ...\n\n", __func__);
@@ -1246,7 +1934,7 @@ int main(int argc, char ** argv) {
                     continue;
                 }
 
-                if ((int) pcmf32_new.size() >= n_samples_step) {
+                if ((int) pcmf32_new.size() >= n_samples_step_eff) {
                     audio.clear();
                     break;
                 }
@@ -1254,11 +1942,18 @@ int main(int argc, char ** argv) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
 
-            // Silence timeout: check new audio for speech before inference
-            // Use a copy because vad_simple() applies high_pass_filter() in-place
-            if (silence_timeout_enabled) {
+            // Speech detection on the raw new audio feeds both the silence
+            // timeout and the --vad-gate. Use a copy because vad_simple()
+            // applies high_pass_filter() in-place
+            bool new_audio_has_speech = true;
+            if (silence_timeout_enabled || params.vad_gate) {
                 std::vector<float> pcmf32_vad(pcmf32_new);
-                bool new_audio_has_speech = ::vad_simple(pcmf32_vad, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false);
+                perf_stats::ScopedTimer timer("vad_simple");
+                new_audio_has_speech = ::vad_simple(pcmf32_vad, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false);
+            }
+
+            // Silence timeout: auto-stop once speech has gone quiet
+            if (silence_timeout_enabled) {
                 if (new_audio_has_speech) {
                     has_spoken = true;
                     t_last_speech = std::chrono::high_resolution_clock::now();
@@ -1274,16 +1969,26 @@ int main(int argc, char ** argv) {
             }
 
             const int n_samples_new = pcmf32_new.size();
-            const int n_samples_take = std::min((int) pcmf32_old.size(), std::max(0, n_samples_keep + n_samples_len - n_samples_new));
+            const int n_samples_take = std::min((int) n_samples_history, std::max(0, n_samples_keep + n_samples_len - n_samples_new));
 
-            pcmf32.resize(n_samples_new + n_samples_take);
+            // Append once to the ring; the window (kept context + new
+            // samples) is read back below as a single contiguous span
+            audio_ring.push(pcmf32_new);
+            n_samples_window = n_samples_new + n_samples_take;
 
-            for (int i = 0; i < n_samples_take; i++) {
-                pcmf32[i] = pcmf32_old[pcmf32_old.size() - n_samples_take + i];
+            // Window boundary bookkeeping lives on the capture side so the
+            // next window can be assembled while the worker is still busy
+            if (((window_index + 1) % n_new_line) == 0) {
+                n_samples_history = n_samples_keep;
+            } else {
+                n_samples_history = n_samples_window;
             }
 
-            memcpy(pcmf32.data() + n_samples_take, pcmf32_new.data(), n_samples_new*sizeof(float));
-            pcmf32_old = pcmf32;
+            // --vad-gate: a silent chunk skips inference entirely. It already
+            // entered the staging ring above, so the keep_ms overlap and the
+            // window assembled for the next speech chunk stay correct — only
+            // the submit below is skipped.
+            gate_skip = params.vad_gate && !new_audio_has_speech;
         } else {
             const auto t_now  = std::chrono::high_resolution_clock::now();
             const auto t_diff = std::chrono::duration_cast<std::chrono::milliseconds>(t_now - t_last).count();
@@ -1293,9 +1998,18 @@ int main(int argc, char ** argv) {
                 continue;
             }
 
-            audio.get(2000, pcmf32_new);
+            {
+                perf_stats::ScopedTimer timer("audio_get");
+                audio.get(2000, pcmf32_new);
+            }
+
+            bool vad_has_speech;
+            {
+                perf_stats::ScopedTimer timer("vad_simple");
+                vad_has_speech = ::vad_simple(pcmf32_new, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false);
+            }
 
-            if (::vad_simple(pcmf32_new, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false)) {
+            if (vad_has_speech) {
                 audio.get(params.length_ms, pcmf32);
                 if (silence_timeout_enabled) {
                     has_spoken = true;
@@ -1318,181 +2032,134 @@ int main(int argc, char ** argv) {
             t_last = t_now;
         }
 
-        // Apply audio normalization before inference
-        if (params.normalize_audio) {
-            normalize_audio(pcmf32);
-        }
-
-        // Run inference via bilingual processing pipeline
+        // Pipelined inference: collect the previous window's results, emit
+        // them, then hand the worker the freshly assembled window. Capture
+        // keeps running while whisper_full() processes the previous one.
         {
-            // Note: whisper_full_params are configured inside process_audio_segment()
-            std::vector<BilingualSegment> bilingual_results;
-            if (process_audio_segment(ctx, ctx_translate, params, pcmf32, bilingual_results, prompt_tokens) != 0) {
-                fprintf(stderr, "%s: failed to process audio\n", argv[0]);
-                whisper_free(ctx);
-                if (ctx_translate) whisper_free(ctx_translate);
-                return 6;
-            }
-
-            // Apply hallucination filter
-            for (auto& seg : bilingual_results) {
-                if (!seg.original_text.empty()) {
-                    seg.original_text = filter_hallucinations(seg.original_text);
-                }
-                if (!seg.english_text.empty()) {
-                    seg.english_text = filter_hallucinations(seg.english_text);
-                }
-            }
-            // Remove segments where both texts became empty after filtering
-            bilingual_results.erase(
-                std::remove_if(bilingual_results.begin(), bilingual_results.end(),
-                    [](const BilingualSegment& s) {
-                        return s.original_text.empty() && s.english_text.empty();
-                    }),
-                bilingual_results.end());
-
-            // Print results
-            {
-                // In sliding window mode, only accumulate to meeting/auto-copy/export/fout
-                // at finalization boundaries (when the window has the most complete text).
-                // VAD mode: every iteration is independent, so always accumulate.
-                const bool is_boundary = use_vad || (((n_iter + 1) % n_new_line) == 0);
-
-                // For pipe mode: clear current buffer before re-rendering
-                if (!stdout_is_tty && !use_vad) {
-                    pipe_current_text.str("");
-                    pipe_current_text.clear();
-                }
-
-                if (!use_vad) {
-                    if (stdout_is_tty) {
-                        printf("\33[2K\r");
-                        printf("%s", std::string(100, ' ').c_str());
-                        printf("\33[2K\r");
-                    }
-                } else {
-                    const int64_t t1 = (t_last - t_start).count()/1000000;
-                    const int64_t t0 = std::max(0.0, t1 - pcmf32.size()*1000.0/WHISPER_SAMPLE_RATE);
-                    if (stdout_is_tty) {
-                        printf("\n### Transcription %d START | t0 = %d ms | t1 = %d ms\n", n_iter, (int) t0, (int) t1);
-                        printf("\n");
+            InferenceJob done;
+            if (worker.collect(done)) {
+                if (done.rc != 0) {
+                    fprintf(stderr, "%s: failed to process audio\n", argv[0]);
+                    worker.stop();
+                    // Let an in-flight system-stream decode finish before the
+                    // context it runs on is freed
+                    if (system_future.valid()) {
+                        system_future.wait();
                     }
+                    if (state_system) whisper_free_state(state_system);
+                    whisper_free(ctx);
+                    if (state_translate) whisper_free_state(state_translate);
+                    if (ctx_draft) whisper_free(ctx_draft);
+                    return 6;
                 }
 
-                // Use colored token output if enabled, otherwise use segment-based output
-                if (params.print_colors) {
-                    // Print tokens directly from whisper context with colors
-                    const int n_segments = whisper_full_n_segments(ctx);
-                    for (int i = 0; i < n_segments; ++i) {
-                        if (stdout_is_tty) {
-                            if (!params.no_timestamps) {
-                                const int64_t t0 = whisper_full_get_segment_t0(ctx, i);
-                                const int64_t t1 = whisper_full_get_segment_t1(ctx, i);
-                                printf("[%s --> %s]  ", to_timestamp(t0).c_str(), to_timestamp(t1).c_str());
-                            }
-                            print_colored_tokens(ctx, i, params);
-                            printf("\n");
-                        }
-
-                        // Accumulate text for pipe even in color mode (always for display)
-                        const char* seg_text = whisper_full_get_segment_text(ctx, i);
-                        bool speaker_turn = whisper_full_get_segment_speaker_turn_next(ctx, i);
-
-                        // Use shared speaker tracker
-                        int seg_speaker_id = speaker_tracker.get_current();
-                        if (speaker_turn) {
-                            seg_speaker_id = speaker_tracker.on_turn();
-                        }
-
-                        if (!stdout_is_tty) {
-                            pipe_current_text << seg_text;
-                        }
-                        // Only accumulate to persistent buffers at finalization boundaries
-                        if (is_boundary) {
-                            if (params.meeting_mode) {
-                                meeting_session.add_transcription(std::string(seg_text), speaker_turn);
-                                meeting_session.add_transcription(" ");
-                            }
-                            if ((params.auto_copy_enabled && should_auto_copy(auto_copy_session, params)) || params.history_enabled) {
-                                auto_copy_session.transcription_buffer << seg_text;
-                            }
-                            if (params.export_enabled) {
-                                int64_t t0 = whisper_full_get_segment_t0(ctx, i);
-                                int64_t t1 = whisper_full_get_segment_t1(ctx, i);
-                                export_session.segments.emplace_back(t0 / 10, t1 / 10, std::string(seg_text), 1.0f, speaker_turn, speaker_turn ? seg_speaker_id : -1);
-                            }
-                        }
-                    }
-                } else {
-                    // Use segment-based bilingual output
-                    std::ostringstream* pbuf = stdout_is_tty ? nullptr : &pipe_current_text;
-                    print_bilingual_results(bilingual_results, params, auto_copy_session, export_session, speaker_tracker, &meeting_session,
-                                            stdout_is_tty, pbuf, is_boundary);
+                // Backpressure: inference slower than the capture step means
+                // the sliding window is falling behind real time
+                if (!use_vad && done.inference_ms > params.step_ms) {
+                    ++n_windows_behind;
+                    fprintf(stderr, "\n%s: WARNING: inference took %d ms for a %d ms step — falling behind real time\n",
+                            __func__, (int) done.inference_ms, params.step_ms);
                 }
 
-                if (is_boundary && params.fname_out.length() > 0) {
-                    const int n_seg = whisper_full_n_segments(ctx);
-                    for (int i = 0; i < n_seg; ++i) {
-                        const char* seg_text = whisper_full_get_segment_text(ctx, i);
-                        if (seg_text) {
-                            fout << seg_text;
-                        }
+                // Adaptive step: rolling RTF (decode wall time over window
+                // audio duration) nudges the effective step — shrink for
+                // snappier output while decoding is comfortably ahead of real
+                // time, grow toward the cap as it approaches parity. The
+                // decision trace lands in the --stats histogram.
+                if (params.adaptive_step && !use_vad && !done.audio.empty()) {
+                    const double window_ms = 1000.0 * done.audio.size() / WHISPER_SAMPLE_RATE;
+                    const double rtf = done.inference_ms / window_ms;
+                    decode_rtf_ema = decode_rtf_ema <= 0.0 ? rtf : 0.7 * decode_rtf_ema + 0.3 * rtf;
+
+                    int step_eff = n_samples_step_eff;
+                    if (decode_rtf_ema < 0.5) {
+                        step_eff = (int) (step_eff * 0.8);
+                    } else if (decode_rtf_ema > 0.85) {
+                        step_eff = (int) (step_eff * 1.25);
                     }
-                    fout << std::endl;
-                    fout.flush();
+                    n_samples_step_eff = std::max(n_samples_step_min, std::min(n_samples_step_max, step_eff));
+                    perf_stats::record("adaptive_step_ms", 1000.0 * n_samples_step_eff / WHISPER_SAMPLE_RATE);
                 }
 
-                if (use_vad) {
-                    if (stdout_is_tty) {
-                        printf("\n### Transcription %d END\n", n_iter);
-                    }
-                    // In VAD mode, each iteration is independent — finalize immediately
-                    if (!stdout_is_tty) {
-                        pipe_finalized_text += pipe_current_text.str();
-                        pipe_current_text.str("");
-                        pipe_current_text.clear();
-                    }
-                }
+                merge_system_results(done);
+                emit_window(done);
             }
 
-            ++n_iter;
-
-            if (!use_vad && (n_iter % n_new_line) == 0) {
-                if (stdout_is_tty) {
-                    printf("\n");
-                }
-                // Finalize current group's text for pipe output
-                if (!stdout_is_tty) {
-                    pipe_finalized_text += pipe_current_text.str();
-                    pipe_current_text.str("");
-                    pipe_current_text.clear();
+            if (gate_skip) {
+                ++n_chunks_gated;
+            } else {
+                InferenceJob job;
+                if (!use_vad) {
+                    // One copy out of the staging ring — the job owns its window
+                    // because preprocessing mutates it while capture continues
+                    const float* window = audio_ring.span(n_samples_window);
+                    job.audio.assign(window, window + n_samples_window);
+                } else {
+                    job.audio = std::move(pcmf32);
+                    pcmf32.clear();
                 }
-                pcmf32_old = std::vector<float>(pcmf32.end() - n_samples_keep, pcmf32.end());
-
-                if (!params.no_context) {
-                    prompt_tokens.clear();
-                    const int n_segments = whisper_full_n_segments(ctx);
-                    for (int i = 0; i < n_segments; ++i) {
-                        const int token_count = whisper_full_n_tokens(ctx, i);
-                        for (int j = 0; j < token_count; ++j) {
-                            prompt_tokens.push_back(whisper_full_get_token_id(ctx, i, j));
-                        }
-                    }
+                job.window_index = window_index++;
+                job.t_window = t_last;
+                const size_t n_samples_job = job.audio.size();
+                worker.submit(std::move(job), prompt_tokens);
+
+                // Kick off the system-stream decode for the same span. It
+                // runs on state_system concurrently with the worker's
+                // whisper_full() — the parallel multi-state path, not a
+                // second serialized pass through the context.
+                if (dual_capture) {
+                    const int window_ms = (int) (n_samples_job * 1000 / WHISPER_SAMPLE_RATE);
+                    audio_system.get(window_ms, pcmf32_system);
+                    system_future = std::async(std::launch::async,
+                        [&, audio_span = pcmf32_system]() mutable {
+                            preprocess_audio(audio_span, params);
+                            return process_audio_chunk_with_state(ctx, state_system, params,
+                                    audio_span.data(), audio_span.size(), 0, system_results);
+                        });
                 }
             }
-            fflush(stdout);
         }
     }
 
+    // Drain the last in-flight window
+    {
+        InferenceJob done;
+        if (worker.collect(done) && done.rc == 0) {
+            merge_system_results(done);
+            emit_window(done);
+        }
+    }
+    worker.stop();
+
+    if (n_windows_behind > 0) {
+        fprintf(stderr, "%s: inference fell behind real time on %d window(s)\n", __func__, n_windows_behind);
+    }
+    if (n_chunks_gated > 0) {
+        fprintf(stderr, "%s: VAD gate skipped inference on %d silent chunk(s)\n", __func__, n_chunks_gated);
+    }
+
     audio.pause();
+    if (dual_capture) {
+        audio_system.pause();
+    }
+    // If the drain skipped the merge (failed last window), a system-stream
+    // decode may still be in flight — let it finish before its state and
+    // the context go away
+    if (system_future.valid()) {
+        system_future.wait();
+    }
+    if (state_system) {
+        whisper_free_state(state_system);
+        state_system = nullptr;
+    }
 
     // Refine accumulated text via Claude if enabled (standard mode)
     if (params.refine) {
         // Refine pipe output
-        std::string raw_pipe = pipe_finalized_text + pipe_current_text.str();
+        std::string raw_pipe = pipe_finalized_text.str() + pipe_current_text.str();
         if (!raw_pipe.empty()) {
-            std::string refined = refine_transcription(raw_pipe);
-            pipe_finalized_text = refined;
+            std::string refined = refine_transcription_cached(raw_pipe);
+            pipe_finalized_text.str(refined);
             pipe_current_text.str("");
             pipe_current_text.clear();
         }
@@ -1500,7 +2167,7 @@ int main(int argc, char ** argv) {
         if (params.auto_copy_enabled) {
             std::string raw_copy = auto_copy_session.transcription_buffer.str();
             if (!raw_copy.empty()) {
-                std::string refined_copy = refine_transcription(raw_copy);
+                std::string refined_copy = refine_transcription_cached(raw_copy);
                 auto_copy_session.transcription_buffer.str("");
                 auto_copy_session.transcription_buffer.clear();
                 auto_copy_session.transcription_buffer << refined_copy;
@@ -1510,7 +2177,7 @@ int main(int argc, char ** argv) {
 
     // Dump accumulated text to stdout when not a TTY (pipe/redirect mode)
     if (!stdout_is_tty) {
-        std::string final_text = pipe_finalized_text + pipe_current_text.str();
+        std::string final_text = pipe_finalized_text.str() + pipe_current_text.str();
         if (!final_text.empty()) {
             printf("%s\n", final_text.c_str());
             fflush(stdout);
@@ -1522,7 +2189,7 @@ int main(int argc, char ** argv) {
     if (params.meeting_mode) {
         history_text = meeting_session.get_transcription();
     } else if (!stdout_is_tty) {
-        history_text = pipe_finalized_text + pipe_current_text.str();
+        history_text = pipe_finalized_text.str() + pipe_current_text.str();
     } else {
         history_text = auto_copy_session.transcription_buffer.str();
     }
@@ -1536,10 +2203,15 @@ int main(int argc, char ** argv) {
     
     whisper_free(ctx);
 
-    // Clean up translation context if it was created
-    if (ctx_translate) {
-        whisper_free(ctx_translate);
+    // Clean up translation state if it was created
+    if (state_translate) {
+        whisper_free_state(state_translate);
     }
+    if (ctx_draft) {
+        whisper_free(ctx_draft);
+    }
+
+    perf_stats::print_summary();
 
     return 0;
 }
\ No newline at end of file
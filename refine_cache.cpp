@@ -0,0 +1,397 @@
+#include "refine_cache.h"
+#include "text_processing.h"
+
+#include <sqlite3.h>
+#include <filesystem>
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const int MAX_MEMO_ENTRIES = 2000; // memo rows kept, evicted by last_used
+static const int RULE_MIN_HITS = 2;       // a word fix must be seen twice before it applies
+
+// ---------------------------------------------------------------------------
+// Construction / destruction
+// ---------------------------------------------------------------------------
+
+RefineCache::RefineCache() = default;
+
+RefineCache::~RefineCache() {
+    close();
+}
+
+// ---------------------------------------------------------------------------
+// open / close
+// ---------------------------------------------------------------------------
+
+bool RefineCache::open(const std::string& db_path) {
+    if (db_ != nullptr) {
+        close();
+    }
+
+    if (db_path.empty()) {
+        const char* home = std::getenv("HOME");
+        if (!home) {
+            std::cerr << "[refine] HOME not set\n";
+            return false;
+        }
+        db_path_ = std::string(home) + "/.recognize/refine-cache.db";
+    } else {
+        db_path_ = db_path;
+    }
+
+    fs::path parent = fs::path(db_path_).parent_path();
+    if (!parent.empty()) {
+        std::error_code ec;
+        fs::create_directories(parent, ec);
+        if (ec) {
+            std::cerr << "[refine] cannot create directory " << parent
+                      << ": " << ec.message() << "\n";
+            return false;
+        }
+    }
+
+    int rc = sqlite3_open(db_path_.c_str(), &db_);
+    if (rc != SQLITE_OK) {
+        std::cerr << "[refine] cannot open cache: " << sqlite3_errmsg(db_) << "\n";
+        sqlite3_close_v2(db_);
+        db_ = nullptr;
+        return false;
+    }
+
+    sqlite3_exec(db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db_, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+
+    if (!ensure_schema()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void RefineCache::close() {
+    if (db_ != nullptr) {
+        sqlite3_close_v2(db_);
+        db_ = nullptr;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Schema
+// ---------------------------------------------------------------------------
+
+bool RefineCache::ensure_schema() {
+    const char* sql = R"(
+        CREATE TABLE IF NOT EXISTS memo (
+            hash      TEXT PRIMARY KEY,
+            raw       TEXT NOT NULL,
+            refined   TEXT NOT NULL,
+            hits      INTEGER NOT NULL DEFAULT 1,
+            last_used TEXT NOT NULL DEFAULT (strftime('%Y-%m-%dT%H:%M:%S','now','localtime'))
+        );
+        CREATE INDEX IF NOT EXISTS idx_memo_last_used ON memo(last_used);
+        CREATE TABLE IF NOT EXISTS rules (
+            wrong TEXT PRIMARY KEY,
+            right TEXT NOT NULL,
+            hits  INTEGER NOT NULL DEFAULT 1
+        );
+    )";
+
+    char* err = nullptr;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+        std::cerr << "[refine] schema error: " << (err ? err : "unknown") << "\n";
+        sqlite3_free(err);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Normalization / hashing
+// ---------------------------------------------------------------------------
+
+// Lowercase, drop punctuation (apostrophes kept), collapse whitespace — so
+// "Run the tests." and "run the tests" memoize to the same key
+std::string RefineCache::normalize(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    bool pending_space = false;
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isspace(uc)) {
+            pending_space = !out.empty();
+        } else if (std::isalnum(uc) || c == '\'' || uc >= 0x80) {
+            if (pending_space) {
+                out += ' ';
+                pending_space = false;
+            }
+            out += static_cast<char>(std::tolower(uc));
+        }
+        // other punctuation dropped
+    }
+    return out;
+}
+
+// FNV-1a 64-bit — stable across runs (std::hash makes no such promise)
+std::string RefineCache::hash_hex(const std::string& text) {
+    uint64_t h = 1469598103934665603ULL;
+    for (char c : text) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+    return buf;
+}
+
+// ---------------------------------------------------------------------------
+// Memo layer
+// ---------------------------------------------------------------------------
+
+std::optional<std::string> RefineCache::lookup(const std::string& raw_text) {
+    if (db_ == nullptr || raw_text.empty()) {
+        return std::nullopt;
+    }
+
+    std::string key = hash_hex(normalize(raw_text));
+
+    const char* sql = "SELECT refined FROM memo WHERE hash = ?;";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return std::nullopt;
+    }
+    sqlite3_bind_text(stmt, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+
+    std::optional<std::string> result;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        const unsigned char* p = sqlite3_column_text(stmt, 0);
+        result = p ? reinterpret_cast<const char*>(p) : "";
+    }
+    sqlite3_finalize(stmt);
+
+    if (result) {
+        // Touch for LRU eviction
+        const char* touch_sql =
+            "UPDATE memo SET hits = hits + 1, "
+            "last_used = strftime('%Y-%m-%dT%H:%M:%S','now','localtime') WHERE hash = ?;";
+        sqlite3_stmt* touch = nullptr;
+        if (sqlite3_prepare_v2(db_, touch_sql, -1, &touch, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(touch, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(touch);
+            sqlite3_finalize(touch);
+        }
+    }
+
+    return result;
+}
+
+void RefineCache::store(const std::string& raw_text, const std::string& refined_text) {
+    if (db_ == nullptr || raw_text.empty() || refined_text.empty()) {
+        return;
+    }
+
+    std::string key = hash_hex(normalize(raw_text));
+
+    const char* sql =
+        "INSERT OR REPLACE INTO memo (hash, raw, refined) VALUES (?, ?, ?);";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, raw_text.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, refined_text.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+
+    learn_rules(raw_text, refined_text);
+    prune();
+}
+
+void RefineCache::prune() {
+    if (db_ == nullptr) {
+        return;
+    }
+    const char* sql =
+        "DELETE FROM memo WHERE hash NOT IN "
+        "(SELECT hash FROM memo ORDER BY last_used DESC LIMIT ?);";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, MAX_MEMO_ENTRIES);
+        sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Rule layer
+// ---------------------------------------------------------------------------
+
+// Split into lowercase word cores (letters, digits, apostrophes, hyphens);
+// punctuation and casing are handled at application time
+static std::vector<std::string> tokenize_words(const std::string& text) {
+    std::vector<std::string> words;
+    std::string cur;
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc) || c == '\'' || c == '-' || uc >= 0x80) {
+            cur += static_cast<char>(std::tolower(uc));
+        } else if (!cur.empty()) {
+            words.push_back(cur);
+            cur.clear();
+        }
+    }
+    if (!cur.empty()) {
+        words.push_back(cur);
+    }
+    return words;
+}
+
+// Mine single-word fixes from a (raw, refined) pair. Only pairs with equal
+// word counts are considered — positional pairing then needs no alignment —
+// and only when few words differ, so a genuine rewrite teaches nothing.
+void RefineCache::learn_rules(const std::string& raw_text, const std::string& refined_text) {
+    std::vector<std::string> raw_words = tokenize_words(raw_text);
+    std::vector<std::string> ref_words = tokenize_words(refined_text);
+
+    if (raw_words.empty() || raw_words.size() != ref_words.size()) {
+        return;
+    }
+
+    std::vector<size_t> diffs;
+    for (size_t i = 0; i < raw_words.size(); ++i) {
+        if (raw_words[i] != ref_words[i]) {
+            diffs.push_back(i);
+        }
+    }
+    if (diffs.empty() || diffs.size() > raw_words.size() / 4 + 1) {
+        return;
+    }
+
+    const char* sql =
+        "INSERT INTO rules (wrong, right) VALUES (?, ?) "
+        "ON CONFLICT(wrong) DO UPDATE SET "
+        "hits = CASE WHEN right = excluded.right THEN hits + 1 ELSE 1 END, "
+        "right = excluded.right;";
+
+    for (size_t i : diffs) {
+        const std::string& wrong = raw_words[i];
+        const std::string& right = ref_words[i];
+        if (wrong.size() < 2 || right.size() < 2) {
+            continue; // single letters are too ambiguous to ever auto-fix
+        }
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+            sqlite3_bind_text(stmt, 1, wrong.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, 2, right.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+    }
+}
+
+std::string RefineCache::apply_rules(const std::string& text) {
+    if (db_ == nullptr || text.empty()) {
+        return text;
+    }
+
+    // Rule tables stay small (dozens of entries) — load once per call
+    std::unordered_map<std::string, std::string> rules;
+    const char* sql = "SELECT wrong, right FROM rules WHERE hits >= ?;";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, RULE_MIN_HITS);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const unsigned char* w = sqlite3_column_text(stmt, 0);
+            const unsigned char* r = sqlite3_column_text(stmt, 1);
+            if (w && r) {
+                rules[reinterpret_cast<const char*>(w)] = reinterpret_cast<const char*>(r);
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+    if (rules.empty()) {
+        return text;
+    }
+
+    // Whole-word replace, preserving the original word's leading capital
+    std::string out;
+    out.reserve(text.size());
+    std::string word;
+    auto flush_word = [&]() {
+        if (word.empty()) {
+            return;
+        }
+        std::string lower;
+        lower.reserve(word.size());
+        for (char c : word) {
+            lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        auto it = rules.find(lower);
+        if (it == rules.end()) {
+            out += word;
+        } else {
+            std::string fixed = it->second;
+            if (std::isupper(static_cast<unsigned char>(word[0])) &&
+                std::islower(static_cast<unsigned char>(fixed[0]))) {
+                fixed[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(fixed[0])));
+            }
+            out += fixed;
+        }
+        word.clear();
+    };
+
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc) || c == '\'' || c == '-' || uc >= 0x80) {
+            word += c;
+        } else {
+            flush_word();
+            out += c;
+        }
+    }
+    flush_word();
+
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// refine_transcription_cached
+// ---------------------------------------------------------------------------
+
+std::string refine_transcription_cached(const std::string& raw_text, int timeout_seconds) {
+    if (raw_text.empty()) {
+        return raw_text;
+    }
+
+    // One cache per process — refinement runs on the session exit path only
+    static RefineCache cache;
+    static bool cache_open = cache.open();
+
+    if (cache_open) {
+        if (auto hit = cache.lookup(raw_text)) {
+            fprintf(stderr, "[refine] cache hit — skipping Claude round-trip\n");
+            return *hit;
+        }
+    }
+
+    // Apply learned word fixes before the CLI pass: known errors are gone
+    // even if the CLI fails, and the model sees cleaner input
+    std::string pre = cache_open ? cache.apply_rules(raw_text) : raw_text;
+    std::string refined = refine_transcription(pre, timeout_seconds);
+
+    // refine_transcription returns its input on failure, so only memoize
+    // when the CLI was actually reachable — a cached non-correction is
+    // valid, a cached "CLI was missing" result is not
+    if (cache_open && is_claude_cli_available()) {
+        cache.store(raw_text, refined);
+    }
+
+    return refined;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <optional>
+
+struct sqlite3;
+
+// Persistent cache for --refine results, so repeated transcripts skip the
+// 2-5s Claude CLI round-trip entirely. Two layers, both SQLite-backed in
+// ~/.recognize/refine-cache.db:
+//
+//   1. Memo: refined text keyed on a hash of the normalized transcript.
+//      An exact repeat (common for short voice commands) returns instantly.
+//   2. Rules: single-word ASR fixes mined from accumulated (raw, refined)
+//      pairs — the "MCP not NCP" class. A fix observed at least twice is
+//      applied locally with no subprocess.
+class RefineCache {
+public:
+    RefineCache();
+    ~RefineCache();
+
+    bool open(const std::string& db_path = "");
+    void close();
+
+    // Memo layer: exact lookup on the normalized-transcript hash
+    std::optional<std::string> lookup(const std::string& raw_text);
+    void store(const std::string& raw_text, const std::string& refined_text);
+
+    // Rule layer: apply learned word fixes (hits >= RULE_MIN_HITS) in place
+    std::string apply_rules(const std::string& text);
+
+private:
+    sqlite3* db_ = nullptr;
+    std::string db_path_;
+
+    bool ensure_schema();
+    void learn_rules(const std::string& raw_text, const std::string& refined_text);
+    void prune();
+
+    static std::string normalize(const std::string& text);
+    static std::string hash_hex(const std::string& text);
+};
+
+// Drop-in replacement for refine_transcription(): memo hit returns
+// immediately; on a miss the learned rules are applied first, the Claude CLI
+// corrects the remainder, and the result is memoized. If the CLI fails the
+// rule-corrected text is returned rather than the raw transcript.
+std::string refine_transcription_cached(const std::string& raw_text, int timeout_seconds = 30);
@@ -0,0 +1,382 @@
+#include "serve_manager.h"
+#include "audio_processor.h"
+#include "text_processing.h"
+
+#include "common.h"
+#include "audio_capture.h"
+#include "whisper.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Shared interrupt flag set by the SIGINT handler in recognize.cpp
+extern std::atomic<bool> g_interrupt_received;
+extern std::atomic<bool> g_is_recording;
+
+// Hard cap on a single served session — a client that never goes silent
+// (or died without closing the socket) cannot pin the mic forever
+static const int MAX_SESSION_SECONDS = 600;
+
+std::string server_socket_path() {
+    const char* home = getenv("HOME");
+    if (!home) return "";
+    return std::string(home) + "/.recognize/recognize.sock";
+}
+
+// Write a full line to the socket; returns false when the peer is gone
+static bool send_line(int fd, const std::string& line) {
+    std::string out = line + "\n";
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t n = write(fd, out.data() + sent, out.size() - sent);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Read one newline-terminated line (bounded); returns false on EOF/error
+static bool recv_line(int fd, std::string& line, int timeout_ms) {
+    line.clear();
+    char c;
+    auto t_start = std::chrono::steady_clock::now();
+    while (true) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int pr = poll(&pfd, 1, 100);
+        if (pr < 0) return false;
+        if (pr == 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - t_start).count();
+            if (elapsed > timeout_ms) return false;
+            continue;
+        }
+        ssize_t n = read(fd, &c, 1);
+        if (n <= 0) return false;
+        if (c == '\n') return true;
+        if (line.size() < 4096) line += c;
+    }
+}
+
+// Has the client hung up? (non-blocking peek)
+static bool peer_closed(int fd) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 0) <= 0) return false;
+    char buf;
+    ssize_t n = recv(fd, &buf, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n == 0;
+}
+
+// Apply per-session overrides from "SESSION key=value ..." to a params copy
+static void apply_session_overrides(const std::string& request, whisper_params& params) {
+    std::istringstream ss(request);
+    std::string token;
+    ss >> token; // "SESSION"
+    while (ss >> token) {
+        size_t eq = token.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+        try {
+            if (key == "silence_timeout")   params.silence_timeout = std::stof(value);
+            else if (key == "language")     params.language = value;
+            else if (key == "output_mode")  params.output_mode = value;
+            else if (key == "translate")    params.translate = (value == "1");
+        } catch (const std::exception&) {
+            // Ignore malformed values — session runs with server defaults
+        }
+    }
+}
+
+// Turn away clients that connected while a session holds the mic — without
+// this they would sit in the listen backlog until the session ends
+static void reject_pending_clients(int listen_fd) {
+    while (true) {
+        struct pollfd pfd = { listen_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 0) <= 0) {
+            return;
+        }
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        send_line(fd, "BUSY");
+        close(fd);
+    }
+}
+
+// Run one capture session and stream finalized text to the client.
+// Uses the same VAD chunking + silence-timeout semantics as /r auto-stop.
+static void serve_session(int client_fd, int listen_fd, struct whisper_context* ctx,
+                          struct whisper_state* state_translate,
+                          whisper_params params, audio_capture& audio) {
+    const float silence_timeout = params.silence_timeout > 0.0f ? params.silence_timeout : 5.0f;
+
+    audio.clear();
+    g_is_recording.store(true);
+
+    std::vector<float> pcmf32;
+    std::vector<float> pcmf32_new;
+    std::vector<whisper_token> prompt_tokens;
+
+    auto t_session_start = std::chrono::high_resolution_clock::now();
+    auto t_last = t_session_start;
+    auto t_last_speech = t_session_start;
+    bool has_spoken = false;
+
+    send_line(client_fd, "READY");
+
+    while (!g_interrupt_received.load()) {
+        if (peer_closed(client_fd)) {
+            break;
+        }
+        reject_pending_clients(listen_fd);
+
+        auto t_now = std::chrono::high_resolution_clock::now();
+        auto session_s = std::chrono::duration_cast<std::chrono::seconds>(t_now - t_session_start).count();
+        if (session_s > MAX_SESSION_SECONDS) {
+            break;
+        }
+
+        auto t_diff = std::chrono::duration_cast<std::chrono::milliseconds>(t_now - t_last).count();
+        if (t_diff < 2000) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        audio.get(2000, pcmf32_new);
+
+        if (::vad_simple(pcmf32_new, WHISPER_SAMPLE_RATE, 1000, params.vad_thold, params.freq_thold, false)) {
+            audio.get(params.length_ms, pcmf32);
+            has_spoken = true;
+            t_last_speech = t_now;
+        } else {
+            if (has_spoken) {
+                auto t_silence = std::chrono::duration_cast<std::chrono::milliseconds>(t_now - t_last_speech).count();
+                if (t_silence >= static_cast<int64_t>(silence_timeout * 1000.0f)) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        t_last = t_now;
+
+        preprocess_audio(pcmf32, params);
+
+        std::vector<BilingualSegment> results;
+        if (process_audio_segment(ctx, state_translate, params, pcmf32, results, prompt_tokens) != 0) {
+            send_line(client_fd, "ERR inference failed");
+            break;
+        }
+
+        for (const auto& seg : results) {
+            std::string text;
+            if (params.output_mode == "english") {
+                text = seg.english_text;
+            } else if (params.output_mode == "bilingual") {
+                text = seg.original_text + " / " + seg.english_text;
+            } else {
+                text = seg.original_text;
+            }
+            text = filter_hallucinations(trim_whitespace(text));
+            if (text.empty()) {
+                continue;
+            }
+            // Protocol is line-based — flatten embedded newlines
+            for (char& c : text) {
+                if (c == '\n' || c == '\r') c = ' ';
+            }
+            if (!send_line(client_fd, "TEXT " + text)) {
+                g_is_recording.store(false);
+                return;
+            }
+        }
+    }
+
+    send_line(client_fd, "DONE");
+    g_is_recording.store(false);
+}
+
+int run_transcription_server(struct whisper_context* ctx, struct whisper_state* state_translate,
+                             const whisper_params& params, audio_capture& audio) {
+    std::string sock_path = server_socket_path();
+    if (sock_path.empty()) {
+        fprintf(stderr, "error: HOME not set, cannot create server socket\n");
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        fprintf(stderr, "error: socket() failed: %s\n", strerror(errno));
+        return 1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (sock_path.size() >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "error: socket path too long: %s\n", sock_path.c_str());
+        close(listen_fd);
+        return 1;
+    }
+    strncpy(addr.sun_path, sock_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    // Remove a stale socket from a previous server instance
+    unlink(sock_path.c_str());
+
+    if (bind(listen_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listen_fd, 4) != 0) {
+        fprintf(stderr, "error: cannot listen on %s: %s\n", sock_path.c_str(), strerror(errno));
+        close(listen_fd);
+        return 1;
+    }
+
+    // SERVE_READY on stderr for launcher detection (same pattern as PTT_READY)
+    fprintf(stderr, "SERVE_READY\n");
+    if (isatty(STDERR_FILENO)) {
+        fprintf(stderr, "[Serving on %s — model stays resident, Ctrl-C to stop]\n", sock_path.c_str());
+    }
+    fflush(stderr);
+
+    int served = 0;
+    while (!g_interrupt_received.load()) {
+        struct pollfd pfd = { listen_fd, POLLIN, 0 };
+        int pr = poll(&pfd, 1, 200);
+        if (pr <= 0) {
+            continue;
+        }
+
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+
+        std::string request;
+        if (!recv_line(client_fd, request, 5000)) {
+            close(client_fd);
+            continue;
+        }
+
+        if (request.rfind("PING", 0) == 0) {
+            send_line(client_fd, "PONG");
+        } else if (request.rfind("SESSION", 0) == 0) {
+            whisper_params session_params = params;
+            apply_session_overrides(request, session_params);
+            serve_session(client_fd, listen_fd, ctx, state_translate, session_params, audio);
+            ++served;
+        } else {
+            send_line(client_fd, "ERR unknown request");
+        }
+
+        close(client_fd);
+    }
+
+    close(listen_fd);
+    unlink(sock_path.c_str());
+    fprintf(stderr, "[Server stopped after %d session(s)]\n", served);
+    return 0;
+}
+
+int run_transcription_client(const whisper_params& params) {
+    std::string sock_path = server_socket_path();
+    if (sock_path.empty()) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (sock_path.size() >= sizeof(addr.sun_path)) {
+        close(fd);
+        return -1;
+    }
+    strncpy(addr.sun_path, sock_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    std::ostringstream request;
+    request << "SESSION"
+            << " silence_timeout=" << params.silence_timeout
+            << " language=" << params.language
+            << " output_mode=" << params.output_mode
+            << " translate=" << (params.translate ? 1 : 0);
+    if (!send_line(fd, request.str())) {
+        close(fd);
+        return -1;
+    }
+
+    if (isatty(STDERR_FILENO)) {
+        fprintf(stderr, "[Connected to recognize server — start speaking]\n");
+    }
+
+    const bool stdout_is_tty = isatty(STDOUT_FILENO) != 0;
+    std::string transcript;
+    std::string line;
+    // Generous read timeout: sessions legitimately sit quiet while waiting for speech
+    while (recv_line(fd, line, (MAX_SESSION_SECONDS + 30) * 1000)) {
+        if (line == "DONE") {
+            break;
+        }
+        if (line == "BUSY") {
+            fprintf(stderr, "server busy with another session\n");
+            close(fd);
+            return 1;
+        }
+        if (line.rfind("ERR", 0) == 0) {
+            fprintf(stderr, "server error: %s\n", line.c_str());
+            close(fd);
+            return 1;
+        }
+        if (line.rfind("TEXT ", 0) == 0) {
+            std::string text = line.substr(5);
+            if (stdout_is_tty) {
+                printf("%s\n", text.c_str());
+                fflush(stdout);
+            }
+            if (!transcript.empty()) transcript += " ";
+            transcript += text;
+        }
+    }
+    close(fd);
+
+    // Pipe mode: emit the full transcript once at the end (matches the
+    // dual-buffer behavior of a standalone session)
+    if (!stdout_is_tty && !transcript.empty()) {
+        printf("%s\n", transcript.c_str());
+        fflush(stdout);
+    }
+
+    if (params.auto_copy_enabled && !transcript.empty()) {
+        if (copy_to_clipboard_macos(transcript)) {
+            fprintf(stderr, "Transcription copied.\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "whisper_params.h"
+
+#include <string>
+
+struct whisper_context;
+class audio_capture;
+
+// Unix-socket transcription server. Generalizes the --ptt-loop warm-daemon
+// idea: one resident process holds the loaded whisper context (and its
+// CoreML/Metal state) and serves capture sessions to thin clients, so
+// repeat invocations skip model load and warm-up entirely.
+//
+// Protocol (newline-delimited text over a Unix domain socket):
+//   client → server: "SESSION key=value ..."   start a capture session
+//   client → server: "PING"                    liveness check
+//   server → client: "TEXT <line>"             one finalized transcript line
+//   server → client: "DONE"                    session ended
+//   server → client: "BUSY" / "PONG" / "ERR <reason>"
+
+// Socket lives under ~/.recognize/ (same convention as session files)
+std::string server_socket_path();
+
+// Server side: accept loop over an already-initialized context and audio
+// device. Returns the process exit code. Exits on SIGINT.
+int run_transcription_server(struct whisper_context* ctx, struct whisper_state* state_translate,
+                             const whisper_params& params, audio_capture& audio);
+
+// Client side: run one session against a resident server, printing the
+// transcript to stdout. Returns the exit code, or -1 when no server is
+// reachable (caller falls back to a standalone session).
+int run_transcription_client(const whisper_params& params);
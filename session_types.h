@@ -1,6 +1,7 @@
 #pragma once
 
 #include "export_manager.h"
+#include "transcript_journal.h"
 
 #include <chrono>
 #include <random>
@@ -11,7 +12,7 @@
 struct AutoCopySession {
     std::string session_id;
     std::chrono::high_resolution_clock::time_point start_time;
-    std::ostringstream transcription_buffer;
+    TranscriptJournal transcription_buffer;
     bool has_been_copied = false;
 
     AutoCopySession() {
@@ -21,6 +22,7 @@ struct AutoCopySession {
         std::uniform_int_distribution<> dis(100000, 999999);
         session_id = std::to_string(dis(gen));
         start_time = std::chrono::high_resolution_clock::now();
+        transcription_buffer.open("copy-" + session_id);
     }
 };
 
@@ -31,6 +33,22 @@ struct ExportSession {
     std::vector<TranscriptionSegment> segments;
     SessionMetadata metadata;
 
+    // When set, segments are appended straight to disk instead of
+    // accumulating in memory (--export-stream)
+    ExportManager* stream = nullptr;
+
+    // Route a finalized segment to the streaming exporter or the in-memory
+    // buffer for the end-of-session bulk export
+    void add_segment(int64_t start_ms, int64_t end_ms, const std::string& text,
+                     float confidence = 1.0f, bool speaker_turn = false, int speaker_id = -1) {
+        TranscriptionSegment segment(start_ms, end_ms, text, confidence, speaker_turn, speaker_id);
+        if (stream && stream->is_streaming()) {
+            stream->stream_segment(segment);
+        } else {
+            segments.push_back(std::move(segment));
+        }
+    }
+
     ExportSession() {
         // Generate a unique session ID
         std::random_device rd;
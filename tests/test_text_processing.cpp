@@ -79,6 +79,16 @@ void test_filter_whitespace_only() {
     ASSERT_EQ(filter_hallucinations("   "), "");
 }
 
+void test_filter_embedded_kept() {
+    // Phantom phrases only match whole segments — embedded text is speech
+    std::string real = "And then he said thank you for watching the rehearsal.";
+    ASSERT_EQ(filter_hallucinations(real), real);
+}
+
+void test_filter_cjk() {
+    ASSERT_EQ(filter_hallucinations("\xe8\xb0\xa2\xe8\xb0\xa2\xe8\xa7\x82\xe7\x9c\x8b"), "");
+}
+
 void test_filter_dedup() {
     std::string input = "Hello. Hello. Hello. World.";
     std::string result = filter_hallucinations(input);
@@ -139,6 +149,8 @@ int main() {
     TEST(filter_real_speech);
     TEST(filter_empty);
     TEST(filter_whitespace_only);
+    TEST(filter_embedded_kept);
+    TEST(filter_cjk);
     TEST(filter_dedup);
 
     TEST(count_empty);
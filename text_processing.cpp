@@ -1,14 +1,21 @@
 #include "text_processing.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <sstream>
 #include <vector>
 #include <unistd.h>
 
+#ifdef __APPLE__
+#include <objc/message.h>
+#include <objc/runtime.h>
+#endif
+
 std::string trim_whitespace(const std::string& str) {
     size_t start = str.find_first_not_of(" \t\n\r\f\v");
     if (start == std::string::npos) {
@@ -18,12 +25,58 @@ std::string trim_whitespace(const std::string& str) {
     return str.substr(start, end - start + 1);
 }
 
+#ifdef __APPLE__
+// NSPasteboard through the Objective-C runtime — in-process, no fork/exec.
+// Equivalent to:
+//   NSPasteboard *pb = [NSPasteboard generalPasteboard];
+//   [pb clearContents];
+//   [pb setString:text forType:@"public.utf8-plain-text"];
+// Spawning pbcopy costs 30-80ms of fork/exec + pipe setup right on the
+// session exit path; this is sub-millisecond.
+static bool copy_via_nspasteboard(const std::string& text) {
+    typedef id (*msg_obj)(id, SEL);
+    typedef id (*msg_cls)(Class, SEL);
+    typedef id (*msg_cls_cstr)(Class, SEL, const char*);
+    typedef signed char (*msg_set)(id, SEL, id, id);
+
+    Class pasteboard_class = objc_getClass("NSPasteboard");
+    Class string_class    = objc_getClass("NSString");
+    Class pool_class      = objc_getClass("NSAutoreleasePool");
+    if (!pasteboard_class || !string_class || !pool_class) {
+        return false;
+    }
+
+    // stringWithUTF8String: autoreleases — a CLI has no pool, so make one
+    id pool = ((msg_obj) objc_msgSend)(
+        ((msg_cls) objc_msgSend)(pool_class, sel_registerName("alloc")),
+        sel_registerName("init"));
+
+    bool ok = false;
+    id pasteboard = ((msg_cls) objc_msgSend)(pasteboard_class, sel_registerName("generalPasteboard"));
+    id str  = ((msg_cls_cstr) objc_msgSend)(string_class, sel_registerName("stringWithUTF8String:"), text.c_str());
+    id type = ((msg_cls_cstr) objc_msgSend)(string_class, sel_registerName("stringWithUTF8String:"), "public.utf8-plain-text");
+    if (pasteboard && str && type) {
+        ((msg_obj) objc_msgSend)(pasteboard, sel_registerName("clearContents"));
+        ok = ((msg_set) objc_msgSend)(pasteboard, sel_registerName("setString:forType:"), str, type) != 0;
+    }
+
+    ((msg_obj) objc_msgSend)(pool, sel_registerName("drain"));
+    return ok;
+}
+#endif
+
 bool copy_to_clipboard_macos(const std::string& text) {
     if (text.empty()) {
         return false;
     }
 
-    // Use pbcopy on macOS to copy to clipboard
+#ifdef __APPLE__
+    if (copy_via_nspasteboard(text)) {
+        return true;
+    }
+    // Runtime path unavailable (e.g. invalid UTF-8) — fall through to pbcopy
+#endif
+
     FILE* pipe = popen("pbcopy", "w");
     if (!pipe) {
         return false;
@@ -49,14 +102,107 @@ bool is_claude_cli_available() {
     return found;
 }
 
-// Filter common whisper hallucination patterns from transcribed text
-std::string filter_hallucinations(const std::string& text) {
-    if (text.empty()) return text;
+namespace {
+
+// Precompiled multi-pattern matcher for hallucination filtering: a
+// case-folded byte trie built once from the built-in phantom list plus
+// ~/.recognize/suppressions.txt (one phrase per line, '#' comments, a
+// trailing '*' makes the phrase a prefix match like the URL patterns).
+// Matching is a single descent over the segment — no lowercase copies,
+// no per-pattern scans. All patterns are anchored at the segment start,
+// so the automaton needs no failure links.
+class HallucinationMatcher {
+public:
+    static const HallucinationMatcher& instance() {
+        static HallucinationMatcher matcher;
+        return matcher;
+    }
 
-    std::string filtered = text;
+    // True when [begin, end) is exactly a suppressed phrase, or starts
+    // with a prefix-suppressed pattern (URLs, user '*' entries)
+    bool matches(const char* begin, const char* end) const {
+        int node = 0;
+        for (const char* p = begin; p != end; ++p) {
+            auto it = children_[node].find(fold(*p));
+            if (it == children_[node].end()) {
+                return false;
+            }
+            node = it->second;
+            if (flags_[node] & FLAG_PREFIX) {
+                return true;
+            }
+        }
+        return (flags_[node] & FLAG_ENTIRE) != 0;
+    }
+
+private:
+    static constexpr uint8_t FLAG_ENTIRE = 1;
+    static constexpr uint8_t FLAG_PREFIX = 2;
+
+    std::vector<std::map<unsigned char, int>> children_;
+    std::vector<uint8_t> flags_;
 
-    // Known phantom phrases that whisper hallucinates on silence/noise
-    static const std::vector<std::string> phantom_patterns = {
+    static unsigned char fold(char c) {
+        return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    void add_pattern(const std::string& pattern, uint8_t flag) {
+        if (pattern.empty()) return;
+        int node = 0;
+        for (char c : pattern) {
+            auto it = children_[node].find(fold(c));
+            if (it == children_[node].end()) {
+                children_.emplace_back();
+                flags_.push_back(0);
+                it = children_[node].emplace(fold(c), static_cast<int>(children_.size()) - 1).first;
+            }
+            node = it->second;
+        }
+        flags_[node] |= flag;
+    }
+
+    HallucinationMatcher() {
+        children_.emplace_back(); // root
+        flags_.push_back(0);
+
+        for (const auto& pattern : builtin_patterns()) {
+            add_pattern(pattern, FLAG_ENTIRE);
+        }
+        // URL starts are prefix matches: "www.example.com" etc.
+        add_pattern("www.", FLAG_PREFIX);
+        add_pattern("http://", FLAG_PREFIX);
+        add_pattern("https://", FLAG_PREFIX);
+
+        load_user_patterns();
+    }
+
+    void load_user_patterns() {
+        const char* home = getenv("HOME");
+        if (!home) return;
+        std::ifstream file(std::string(home) + "/.recognize/suppressions.txt");
+        if (!file) return;
+
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            std::string phrase = trim_whitespace(line);
+            if (phrase.empty() || phrase[0] == '#') continue;
+            if (phrase.size() > 1 && phrase.back() == '*') {
+                phrase.pop_back();
+                add_pattern(trim_whitespace(phrase), FLAG_PREFIX);
+            } else {
+                add_pattern(phrase, FLAG_ENTIRE);
+            }
+        }
+    }
+
+    static const std::vector<std::string>& builtin_patterns();
+};
+
+// Known phantom phrases that whisper hallucinates on silence/noise.
+// Whole-segment matches only — embedded occurrences are real speech.
+const std::vector<std::string>& HallucinationMatcher::builtin_patterns() {
+    static const std::vector<std::string> patterns = {
         "Thank you for watching",
         "Thanks for watching",
         "Subscribe to my channel",
@@ -70,9 +216,6 @@ std::string filter_hallucinations(const std::string& text) {
         "Amara.org",
         "This video is",
         "In this video",
-        "www.",
-        "http://",
-        "https://",
         "[BLANK_AUDIO]",
         "(upbeat music)",
         "(dramatic music)",
@@ -97,33 +240,25 @@ std::string filter_hallucinations(const std::string& text) {
         "\xe5\xbe\xa1\xe8\xa6\x96\xe8\x81\xb4\xe3\x81\x82\xe3\x82\x8a\xe3\x81\x8c\xe3\x81\xa8\xe3\x81\x86\xe3\x81\x94\xe3\x81\x96\xe3\x81\x84\xe3\x81\xbe\xe3\x81\x99",  // Japanese: "Thank you for watching"
         "\xe8\xb0\xa2\xe8\xb0\xa2\xe8\xa7\x82\xe7\x9c\x8b",  // Chinese: "Thanks for watching"
     };
+    return patterns;
+}
 
-    // Trim whitespace first
-    std::string trimmed = filtered;
-    size_t start = trimmed.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos) return "";
-    size_t end = trimmed.find_last_not_of(" \t\n\r");
-    trimmed = trimmed.substr(start, end - start + 1);
+} // namespace
 
-    // Check if entire text is a single phantom phrase (case-insensitive)
-    auto to_lower = [](unsigned char c) -> char { return std::tolower(c); };
-    std::string lower_trimmed = trimmed;
-    std::transform(lower_trimmed.begin(), lower_trimmed.end(), lower_trimmed.begin(), to_lower);
+// Filter common whisper hallucination patterns from transcribed text
+std::string filter_hallucinations(const std::string& text) {
+    if (text.empty()) return text;
 
-    for (const auto& pattern : phantom_patterns) {
-        std::string lower_pattern = pattern;
-        std::transform(lower_pattern.begin(), lower_pattern.end(), lower_pattern.begin(), to_lower);
+    std::string filtered = text;
 
-        // If entire trimmed text matches a phantom pattern, filter it out
-        if (lower_trimmed == lower_pattern) {
-            return "";
-        }
+    // Trim bounds without copying, then run the precompiled matcher in a
+    // single pass over the trimmed span
+    size_t start = filtered.find_first_not_of(" \t\n\r");
+    if (start == std::string::npos) return "";
+    size_t end = filtered.find_last_not_of(" \t\n\r") + 1;
 
-        // If text starts with a URL pattern, filter it
-        if ((pattern == "www." || pattern == "http://" || pattern == "https://") &&
-            lower_trimmed.find(lower_pattern) == 0) {
-            return "";
-        }
+    if (HallucinationMatcher::instance().matches(filtered.data() + start, filtered.data() + end)) {
+        return "";
     }
 
     // Deduplicate consecutive identical sentences (requires 3+ sentences total)
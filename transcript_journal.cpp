@@ -0,0 +1,186 @@
+#include "transcript_journal.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Initial mapping: holds hours of transcript before the first regrow
+static const size_t JOURNAL_INITIAL_CAPACITY = 256 * 1024;
+
+TranscriptJournal::TranscriptJournal() = default;
+
+TranscriptJournal::~TranscriptJournal() {
+    discard();
+}
+
+bool TranscriptJournal::open(const std::string& tag) {
+    discard();
+
+    const char* home = std::getenv("HOME");
+    if (!home) {
+        return false;
+    }
+
+    std::string dir = std::string(home) + "/.recognize/tmp";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        return false;
+    }
+
+    path_ = dir + "/journal-" + tag + ".txt";
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) {
+        path_.clear();
+        return false;
+    }
+
+    if (ftruncate(fd_, static_cast<off_t>(JOURNAL_INITIAL_CAPACITY)) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        unlink(path_.c_str());
+        path_.clear();
+        return false;
+    }
+
+    void* p = mmap(nullptr, JOURNAL_INITIAL_CAPACITY, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        ::close(fd_);
+        fd_ = -1;
+        unlink(path_.c_str());
+        path_.clear();
+        return false;
+    }
+
+    map_ = static_cast<char*>(p);
+    capacity_ = JOURNAL_INITIAL_CAPACITY;
+    size_ = 0;
+    return true;
+}
+
+// Double the file and remap. macOS has no mremap, so this is
+// munmap + ftruncate + mmap — rare enough (doublings from 256KB) not to matter.
+bool TranscriptJournal::grow(size_t needed) {
+    size_t new_capacity = capacity_;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    munmap(map_, capacity_);
+    map_ = nullptr;
+
+    if (ftruncate(fd_, static_cast<off_t>(new_capacity)) != 0) {
+        return false;
+    }
+
+    void* p = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+
+    map_ = static_cast<char*>(p);
+    capacity_ = new_capacity;
+    return true;
+}
+
+void TranscriptJournal::append(const char* data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    if (map_ == nullptr) {
+        fallback_.append(data, len);
+        size_ = fallback_.size();
+        return;
+    }
+
+    if (size_ + len > capacity_ && !grow(size_ + len)) {
+        // Mapping lost mid-grow: fall back to memory, carrying what we had
+        fallback_.assign("");
+        fallback_.reserve(size_ + len);
+        // The file still holds the first size_ bytes but the map is gone —
+        // reread them so the fallback buffer stays complete
+        if (fd_ >= 0) {
+            fallback_.resize(size_);
+            if (pread(fd_, &fallback_[0], size_, 0) != static_cast<ssize_t>(size_)) {
+                fallback_.clear();
+            }
+            ::close(fd_);
+            fd_ = -1;
+        }
+        fallback_.append(data, len);
+        size_ = fallback_.size();
+        return;
+    }
+
+    memcpy(map_ + size_, data, len);
+    size_ += len;
+}
+
+TranscriptJournal& TranscriptJournal::operator<<(const std::string& s) {
+    append(s.data(), s.size());
+    return *this;
+}
+
+TranscriptJournal& TranscriptJournal::operator<<(const char* s) {
+    if (s) {
+        append(s, strlen(s));
+    }
+    return *this;
+}
+
+TranscriptJournal& TranscriptJournal::operator<<(int v) {
+    std::string s = std::to_string(v);
+    append(s.data(), s.size());
+    return *this;
+}
+
+TranscriptJournal& TranscriptJournal::operator+=(const std::string& s) {
+    append(s.data(), s.size());
+    return *this;
+}
+
+std::string TranscriptJournal::str() const {
+    if (map_ == nullptr) {
+        return fallback_;
+    }
+    return std::string(map_, size_);
+}
+
+void TranscriptJournal::str(const std::string& s) {
+    if (map_ == nullptr) {
+        fallback_ = s;
+        size_ = fallback_.size();
+        return;
+    }
+    size_ = 0;
+    append(s.data(), s.size());
+}
+
+void TranscriptJournal::discard() {
+    if (map_ != nullptr) {
+        munmap(map_, capacity_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    if (!path_.empty()) {
+        unlink(path_.c_str());
+        path_.clear();
+    }
+    capacity_ = 0;
+    size_ = 0;
+    fallback_.clear();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Append-only transcript journal backed by an mmap'd file under
+// ~/.recognize/tmp/. Long sessions used to accumulate the full transcript in
+// growing in-memory streams, with should_auto_copy() copying the whole buffer
+// every segment to check its size — quadratic on all-day meeting boxes. The
+// journal writes each segment once into the mapping (constant per-segment
+// cost), tracks its size as a counter, and reads the text back only when a
+// consumer (copy/export/meeting/history) actually needs it. The file is
+// removed on clean finalize; after a crash it survives in ~/.recognize/tmp/
+// as a recoverable plain-text transcript.
+//
+// The interface mirrors the std::ostringstream it replaces (operator<<,
+// str(), str(s), clear()) so accumulation call sites read the same. If the
+// backing file can't be set up, appends fall back to an in-memory string.
+class TranscriptJournal {
+public:
+    TranscriptJournal();
+    ~TranscriptJournal(); // discards: clean destruction is a clean finalize
+
+    TranscriptJournal(const TranscriptJournal&) = delete;
+    TranscriptJournal& operator=(const TranscriptJournal&) = delete;
+
+    // Create and map ~/.recognize/tmp/journal-<tag>.txt
+    bool open(const std::string& tag);
+
+    void append(const char* data, size_t len);
+
+    TranscriptJournal& operator<<(const std::string& s);
+    TranscriptJournal& operator<<(const char* s);
+    TranscriptJournal& operator<<(int v);
+    TranscriptJournal& operator+=(const std::string& s);
+
+    std::string str() const;       // read the full journal back (one copy)
+    void str(const std::string& s); // truncate and rewrite (post-refinement)
+    void clear() {}                 // stream-API parity; journal has no error state
+
+    // O(1) — replaces the .str().size() full-buffer copy in should_auto_copy()
+    size_t size() const { return size_; }
+
+    // Unmap, close, and unlink the backing file
+    void discard();
+
+private:
+    bool grow(size_t needed);
+
+    int fd_ = -1;
+    char* map_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    std::string path_;
+    std::string fallback_; // used when the mmap setup failed
+};
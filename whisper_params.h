@@ -61,6 +61,7 @@ struct whisper_params {
     bool export_include_metadata = true;
     bool export_include_timestamps = true;
     bool export_include_confidence = false;
+    bool export_stream = false;      // Append segments to disk as they finalize (crash-safe)
 
     // Meeting settings
     bool meeting_mode = false;
@@ -91,9 +92,36 @@ struct whisper_params {
     std::string ptt_key = "space";   // User-friendly key name
     int32_t ptt_pre_roll_ms = 300;  // Capture audio from before key press (catches onset consonants)
 
+    // Server settings
+    bool serve = false;              // Keep the model resident and serve sessions over a Unix socket
+    bool client = false;             // Run a session against a resident --serve process
+
+    // Offline file transcription settings
+    std::string input_file = "";     // --file: transcribe a recording instead of live capture
+    int32_t file_jobs = 0;           // Parallel whisper_states for --file (0 = auto)
+
+    // Partial results settings
+    bool partials = false;           // Stream dim draft text to the TTY while a chunk decodes
+
+    // Adaptive step settings
+    bool adaptive_step = false;      // Scale the effective step with the measured decode RTF
+
+    // Draft model settings
+    std::string draft_model = "";    // Small resident model drafting dim preview text per window
+
+    // VAD gate settings
+    bool vad_gate = false;           // Skip inference entirely for capture chunks with no speech
+
+    // Dual-stream capture settings (meeting mode)
+    int32_t capture_system_id = -1;  // Loopback/aggregate device for system audio (-1 = mic only)
+
     // Refinement settings
     bool refine = false;             // Post-process transcript through Claude for ASR error correction
 
     // History settings
     bool history_enabled = true;     // Save transcripts to ~/.recognize/history.db
+
+    // Diagnostics settings
+    bool stats = false;              // Per-stage timing summary (JSON on stderr) at exit
+    bool stats_stream = false;       // Also print one JSON line per timing sample
 };
\ No newline at end of file